@@ -38,15 +38,77 @@ namespace lsp
             static constexpr float  CHANNEL_GAIN_MAX    = GAIN_AMP_P_12_DB;
             static constexpr float  CHANNEL_GAIN_DFL    = GAIN_AMP_0_DB;
             static constexpr float  CHANNEL_GAIN_STEP   = 0.01f;
+
+            static constexpr float  SEND_GAIN_MIN       = GAIN_AMP_M_INF_DB;
+            static constexpr float  SEND_GAIN_MAX       = GAIN_AMP_P_12_DB;
+            static constexpr float  SEND_GAIN_DFL       = GAIN_AMP_M_INF_DB;
+            static constexpr float  SEND_GAIN_STEP      = 0.01f;
+
+            static constexpr float  CHANNEL_DELAY_MIN   = 0.0f;     // Alignment delay of the channel, ms
+            static constexpr float  CHANNEL_DELAY_MAX   = 50.0f;
+            static constexpr float  CHANNEL_DELAY_DFL   = 0.0f;
+            static constexpr float  CHANNEL_DELAY_STEP  = 0.01f;
+
+            static constexpr size_t RETURN_LATENCY_MIN  = 0;        // Latency of the channel return path, samples
+            static constexpr size_t RETURN_LATENCY_MAX  = 4096;
+            static constexpr size_t RETURN_LATENCY_DFL  = 0;
+            static constexpr size_t RETURN_LATENCY_STEP = 1;
+
+            static constexpr float  AZIMUTH_MIN         = -180.0f;  // Azimuth of the surround strip, degrees clockwise from the front
+            static constexpr float  AZIMUTH_MAX         = 180.0f;
+            static constexpr float  AZIMUTH_DFL         = 0.0f;
+            static constexpr float  AZIMUTH_STEP        = 0.1f;
+
+            static constexpr float  DIVERGENCE_MIN      = 0.0f;     // Divergence of the surround strip, percent
+            static constexpr float  DIVERGENCE_MAX      = 100.0f;
+            static constexpr float  DIVERGENCE_DFL      = 0.0f;
+            static constexpr float  DIVERGENCE_STEP     = 0.1f;
+
+            static constexpr size_t SURROUND_CHANNELS   = 8;        // Number of channels of the surround bus (7.1)
+            static constexpr size_t SURROUND_5_1_CHANNELS   = 6;    // Number of channels used by the 5.1 layout
+
+            static constexpr float  SCENE_FADE_MIN      = 0.0f;     // Crossfade time of the scene recall, ms
+            static constexpr float  SCENE_FADE_MAX      = 10000.0f;
+            static constexpr float  SCENE_FADE_DFL      = 500.0f;
+            static constexpr float  SCENE_FADE_STEP     = 1.0f;
+
+            static constexpr size_t SUBGROUPS           = 4;        // Number of subgroup buses
+            static constexpr size_t VCAS                = 4;        // Number of VCA groups
+            static constexpr size_t AUX_BUSES           = 4;        // Number of aux send buses
+            static constexpr size_t SCENES              = 8;        // Number of scene slots
+
+            static constexpr size_t THREADS_MIN         = 1;
+            static constexpr size_t THREADS_MAX         = 8;
+            static constexpr size_t THREADS_DFL         = 1;
+            static constexpr size_t THREADS_STEP        = 1;
+
+            static constexpr size_t MT_BLOCK_MIN        = 64;
+            static constexpr size_t MT_BLOCK_MAX        = 8192;
+            static constexpr size_t MT_BLOCK_DFL        = 512;
+            static constexpr size_t MT_BLOCK_STEP       = 1;
+
+            static constexpr float  DSP_LOAD_MIN        = 0.0f;     // DSP load in percent of the audio time
+            static constexpr float  DSP_LOAD_MAX        = 1000.0f;
+            static constexpr float  DSP_LOAD_DFL        = 0.0f;
+            static constexpr float  DSP_LOAD_STEP       = 0.001f;
+
+            static constexpr size_t PARALLEL_STRIPS_MIN = 32;       // Minimum number of strips for parallel processing controls
         } mixer;
 
         // Plugin type metadata
         extern const plugin_t mixer_x4_mono;
         extern const plugin_t mixer_x8_mono;
         extern const plugin_t mixer_x16_mono;
+        extern const plugin_t mixer_x32_mono;
+        extern const plugin_t mixer_x64_mono;
         extern const plugin_t mixer_x4_stereo;
         extern const plugin_t mixer_x8_stereo;
         extern const plugin_t mixer_x16_stereo;
+        extern const plugin_t mixer_x32_stereo;
+        extern const plugin_t mixer_x64_stereo;
+        extern const plugin_t mixer_x8_surround;
+        extern const plugin_t mixer_x16_surround;
+        extern const plugin_t mixer_x32_surround;
     } /* namespace meta */
 } /* namespace lsp */
 
@@ -23,9 +23,16 @@
 #define PRIVATE_PLUGINS_MIXER_H_
 
 #include <lsp-plug.in/dsp-units/util/Delay.h>
-#include <lsp-plug.in/dsp-units/ctl/Bypass.h>
+#include <lsp-plug.in/ipc/ITask.h>
 #include <lsp-plug.in/plug-fw/plug.h>
+#include <lsp-plug.in/runtime/system.h>
 #include <private/meta/mixer.h>
+#include <private/plugins/mixer_delays.h>
+#include <private/plugins/mixer_exchange.h>
+#include <private/plugins/mixer_kernels.h>
+#include <private/plugins/mixer_meters.h>
+#include <private/plugins/mixer_scenes.h>
+#include <private/plugins/mixer_workers.h>
 
 namespace lsp
 {
@@ -40,10 +47,63 @@ namespace lsp
                 mixer & operator = (const mixer &);
                 mixer (const mixer &);
 
+            public:
+                // Gain parameters of the parameter exchange, parameters of all strips are
+                // followed by parameters of the master section
+                enum strip_param_t
+                {
+                    SP_GAIN,                            // Fader gain
+                    SP_SEND,                            // Aux send levels
+                    SP_COUNT            = SP_SEND + meta::mixer::AUX_BUSES
+                };
+
+                enum master_param_t
+                {
+                    MP_DRY,                             // Dry signal amount
+                    MP_WET,                             // Wet signal amount
+                    MP_OUT_GAIN,                        // Output gain
+                    MP_VCA,                             // VCA group gains
+                    MP_GROUP            = MP_VCA + meta::mixer::VCAS,           // Subgroup gains
+                    MP_AUX              = MP_GROUP + meta::mixer::SUBGROUPS,    // Aux bus gains
+                    MP_COUNT            = MP_AUX + meta::mixer::AUX_BUSES
+                };
+
             protected:
+                // Bus buffers are addressed as bus * 2 + primary channel, bus 0 is the master bus,
+                // subgroup buses follow it and aux buses follow subgroup buses
+                static constexpr size_t AUX_BUS_FIRST   = meta::mixer::SUBGROUPS + 1;
+                static constexpr size_t BUS_CHANNELS    = (AUX_BUS_FIRST + meta::mixer::AUX_BUSES) * 2;
+                // Number of float arrays in the hot state of mixer channels
+                static constexpr size_t STRIP_STATE_ARRAYS  = 9 + meta::mixer::AUX_BUSES * 2;
+                // Number of float arrays of channel gains at one end of the scene crossfade
+                static constexpr size_t FADE_ARRAYS     = 3 + meta::mixer::AUX_BUSES;
+
+                // Processing stages measured by the DSP load profiler
+                enum prof_stage_t
+                {
+                    PS_MIX,                             // Mixing of strips into buses
+                    PS_METER,                           // Metering of muted and soloed-out strips
+                    PS_GROUPS,                          // Subgroup faders
+                    PS_MASTER,                          // Dry/wet mixing and output balance
+                    PS_BYPASS,                          // Bypass crossfade and output metering
+                    PS_AUX,                             // Aux bus outputs
+                    PS_LOUDNESS,                        // RMS, loudness and true peak metering
+                    PS_TOTAL,                           // Whole processing call
+
+                    PS_COUNT
+                };
+
+                typedef struct loudness_t
+                {
+                    plug::IPort        *pRms;           // RMS level meter
+                    plug::IPort        *pMomentary;     // Momentary loudness meter
+                    plug::IPort        *pShortTerm;     // Short-term loudness meter
+                    plug::IPort        *pTruePeak;      // True peak meter
+                } loudness_t;
+
                 typedef struct primary_channel_t
                 {
-                    dspu::Bypass        sBypass;        // Bypass switch
+                    mix::xfade_t        sBypass;        // Bypass crossfade
 
                     float              *vIn;            // Input buffer pointer
                     float              *vOut;           // Output buffer pointer
@@ -53,8 +113,12 @@ namespace lsp
                     float               fDry;           // Dry signal amount
                     float               fOldWet;        // Old wet signal amount
                     float               fWet;           // Wet signal amount
-                    float               fOldGain[2];    // Old output gain
-                    float               fGain[2];       // Output gain (balanced)
+                    float               fOldLink;       // Old weight of the return link
+                    float               fLink;          // Weight of the return link
+                    float               fInLevel;       // Input level
+                    float               fOutLevel;      // Output level
+                    float              *vHostIn;        // Input buffer of the host, read through the delay line
+                    float              *vHostRet;       // Return buffer of the host, read through the delay line
 
                     plug::IPort        *pIn;            // Input data port
                     plug::IPort        *pOut;           // Output data port
@@ -67,15 +131,36 @@ namespace lsp
                     plug::IPort        *pOutLevel;      // Output level meter
                 } primary_channel_t;
 
+                // Hot state of mixer channels accessed by the processing loop, stored as
+                // structure of arrays: each array holds one element per mixer channel
+                typedef struct strips_t
+                {
+                    float             **vIn;            // Input buffers
+                    float             **vRet;           // Return buffers
+                    float              *vOldGain[2];    // Old gain values
+                    float              *vGain[2];       // Gains for left and right outputs
+                    float              *vOldPostGain;   // Old post-gain values (after metering stage)
+                    float              *vPostGain;      // Post-gains (after metering stage)
+                    float              *vOldSend[meta::mixer::AUX_BUSES];   // Old aux send gains
+                    float              *vSend[meta::mixer::AUX_BUSES];      // Aux send gains (including post-gain)
+                    float              *vOutLevel;      // Output levels
+                    float              *vPan;           // Panning of channels of stereo strips
+                    float              *vBalance;       // Balance of stereo strips, stored for each channel of the strip
+                } strips_t;
+
+                // Cold state of the mixer channel: settings and port bindings
                 typedef struct mix_channel_t
                 {
-                    float              *vIn;            // Input buffer
-                    float              *vRet;           // Return buffer
-                    float               fOldGain[2];    // Old gain value
-                    float               fGain[2];       // Gain for left and right outputs
-                    float               fOldPostGain;   // Old post-gain value (after metering stage)
-                    float               fPostGain;      // Post-gain (after metering stage)
-                    bool                bSolo;          // Solo flag
+                    size_t              nGroup;         // Output bus: 0 for master, subgroup number otherwise
+                    uint64_t            nProfCycles;    // Counter ticks spent on the strip in the profiling window
+                    float               fProfLoad;      // DSP load of the strip
+                    mix::strip_settings_t   sSet;       // Settings in effect
+                    mix::strip_settings_t   sPort;      // Settings last read from ports
+                    float               fDelay;         // Alignment delay
+                    float               fRetLatency;    // Latency of the return path
+                    bool                bDirty;         // Settings have changed since the last update
+                    float              *vHostIn;        // Input buffer of the host, read through the delay line
+                    float              *vHostRet;       // Return buffer of the host, read through the delay line
 
                     plug::IPort        *pIn;            // Input data port
                     plug::IPort        *pRet;           // Input return port
@@ -86,28 +171,268 @@ namespace lsp
                     plug::IPort        *pBalance;       // Balance port
                     plug::IPort        *pOutGain;       // Output gain
                     plug::IPort        *pOutLevel;      // Output level meter
+                    plug::IPort        *pGroup;         // Subgroup assignment
+                    plug::IPort        *pVca;           // VCA group assignment
+                    plug::IPort        *pSend[meta::mixer::AUX_BUSES];      // Aux send levels
+                    plug::IPort        *pProfLoad;      // DSP load meter of the strip
+                    loudness_t          sLoudness;      // Loudness meters of the strip
+                    plug::IPort        *pDelay;         // Alignment delay
+                    plug::IPort        *pRetLatency;    // Latency of the return path
                 } mix_channel_t;
 
+                typedef struct subgroup_t
+                {
+                    float              *vData[2];       // Subgroup bus for each primary channel
+                    float               fOldGain;       // Old subgroup gain
+                    float               fGain;          // Subgroup gain
+                    float               fOutLevel[2];   // Output level
+                    bool                bActive;        // Subgroup has channels routed to it
+
+                    plug::IPort        *pMute;          // Mute switch
+                    plug::IPort        *pGain;          // Subgroup gain
+                    plug::IPort        *pOutLevel[2];   // Output level meters
+                    loudness_t          sLoudness;      // Loudness meters
+                } subgroup_t;
+
+                typedef struct aux_t
+                {
+                    float              *vData[2];       // Aux bus for each primary channel
+                    float              *vOut[2];        // Output buffer pointers
+                    float               fOldGain;       // Old aux gain
+                    float               fGain;          // Aux gain
+                    float               fOutLevel[2];   // Output level
+                    bool                bPre;           // Pre-fader tap
+                    bool                bActive;        // Aux bus has channels sent to it
+
+                    plug::IPort        *pOut[2];        // Output data ports
+                    plug::IPort        *pPre;           // Pre-fader tap switch
+                    plug::IPort        *pGain;          // Aux gain
+                    plug::IPort        *pOutLevel[2];   // Output level meters
+                    loudness_t          sLoudness;      // Loudness meters
+                } aux_t;
+
+                typedef struct route_t
+                {
+                    size_t              nChannel;       // Index of the mixer channel (left channel of the pair for stereo)
+                    size_t              nBus;           // Destination bus: 0 for master, subgroup number otherwise
+                    size_t              nTaps;          // Number of aux sends
+                    uint8_t             vTaps[meta::mixer::AUX_BUSES];      // Aux buses the channel is sent to
+                } route_t;
+
+                // Gains of the mix at one end of the scene crossfade
+                typedef struct scene_gains_t
+                {
+                    float              *vGain[2];       // Gains of channels for left and right outputs
+                    float              *vPostGain;      // Post-gains of channels
+                    float              *vSend[meta::mixer::AUX_BUSES];      // Aux send gains of channels
+                    float               fDry[2];        // Dry signal amount of primary channels
+                    float               fWet[2];        // Wet signal amount of primary channels
+                    float               fBalance[2][2]; // Balance and mono fold-down matrix
+                    float               vGroup[meta::mixer::SUBGROUPS];     // Subgroup gains
+                    float               vAux[meta::mixer::AUX_BUSES];       // Aux bus gains
+                } scene_gains_t;
+
+                typedef struct partial_bus_t
+                {
+                    float              *vData[BUS_CHANNELS];    // Partial bus data for each bus and primary channel
+                    bool                bUsed;          // Partial bus contains data of the current batch
+                } partial_bus_t;
+
+                /**
+                 * Offline task that exchanges scenes and names of channels with the KVT storage,
+                 * the processing thread only copies scenes to the task and swaps read scenes in
+                 */
+                class SceneSync: public ipc::ITask
+                {
+                    private:
+                        SceneSync & operator = (const SceneSync &);
+                        SceneSync(const SceneSync &);
+
+                        friend class mixer;
+
+                    private:
+                        mixer              *pMixer;
+                        mix::SceneBank      sBank;          // Scenes to write to KVT and scenes read from KVT
+                        uint32_t            nSave;          // Scenes to write to KVT
+                        ssize_t             nNames;         // Scene to restore names of channels from, negative if none
+                        bool                bLoad;          // Scenes should be read from KVT
+                        uatomic_t           nCancel;        // Non-zero if the task should not access KVT anymore
+
+                    protected:
+                        void                save_scenes(core::KVTStorage *kvt, size_t strips);
+                        void                restore_names(core::KVTStorage *kvt, size_t strips);
+                        void                load_scenes(core::KVTStorage *kvt);
+
+                    public:
+                        explicit SceneSync(mixer *m);
+                        virtual ~SceneSync() override;
+
+                    public:
+                        virtual status_t    run() override;
+                };
+
             protected:
                 primary_channel_t  *vPChannels;         // Primary channels
                 mix_channel_t      *vMChannels;         // Mixer input channels
+                strips_t            sStrips;            // Hot state of mixer input channels
                 size_t              nPChannels;         // Number of primary channels (1 for mono, 2 for stereo)
                 size_t              nMChannels;         // Number of mixer channels
+                size_t              nTileSize;          // Size of the processing tile in samples
                 bool                bMonoOut;           // Mono output (for stereo mixer)
+                mix::matrix_t       sBalance;           // Balance and mono fold-down matrix of the stereo output
                 float              *vWet[2];            // Wet buffers
                 float              *vTemp[2];           // Temporary buffers
+                float              *vRamp[2];           // Ramp shapes of the full tile and of the shorter tile
+                size_t              nRampLength;        // Length of the ramp shape of the shorter tile
+                float              *vBus[BUS_CHANNELS]; // Master and subgroup buses
+                subgroup_t          vSubgroups[meta::mixer::SUBGROUPS]; // Subgroups
+                aux_t               vAux[meta::mixer::AUX_BUSES];       // Aux send buses
+                route_t            *vRoutes;            // Routing table of audible channels
+                size_t             *vSilent;            // Indices of muted and soloed-out channels
+                size_t              nRoutes;            // Number of routes
+                size_t              nSilent;            // Number of muted and soloed-out channels
+                bool                bRebuild;           // Routing table should be rebuilt after the end of gain transition
+                size_t              nSolo;              // Number of soloed channels
+                mix::master_settings_t  sMaster;        // Settings of the master section in effect
+                mix::master_settings_t  sMasterPort;    // Settings of the master section last read from ports
+
+                mix::WorkerPool     sWorkers;           // Worker threads for parallel strip processing
+                partial_bus_t      *vPartial;           // Partial buses of threads for parallel strip processing
+                bool                bParallel;          // Parallel processing is supported
+                size_t              nThreads;           // Number of processing threads
+                size_t              nMtBlock;           // Minimum block size for parallel processing
+                size_t              nRouteJobs;         // Number of jobs that mix routes
+                size_t              nSilentJobs;        // Number of jobs that meter silent strips
+                size_t              nMeterJobs;         // Number of jobs that perform loudness metering of strips
+                size_t              nJobSamples;        // Number of samples to process by each job
+                mix::job_func_t     pJobFunc;           // Job function specialised for the engine
+
+                bool                bProfile;           // DSP load profiling is enabled
+                size_t              nProfSamples;       // Number of samples processed in the profiling window
+                size_t              nProfWindow;        // Size of the profiling window in samples
+                uint64_t            vProfCycles[PS_COUNT];  // Counter ticks spent on each stage in the profiling window
+                uint64_t            nProfStart;         // Counter value at the start of the profiling window
+                system::time_t      sProfStart;         // Wall clock time at the start of the profiling window
+                float               vProfLoad[PS_COUNT];    // DSP load of each stage
+
+                mix::MeterBank      sStripMeters;       // Loudness meters of mixer channels
+                mix::MeterBank      sBusMeters;         // Loudness meters of the master bus, subgroups and aux buses
+                bool                bLoudness;          // Loudness metering is enabled
+
+                mix::DelayArena     sDelays;            // Delay lines of inputs (even) and returns (odd) of channels, then of primary channels
+                size_t             *vDelayed;           // Indices of channels with non-zero delay
+                size_t              nDelayed;           // Number of channels with non-zero delay
+                size_t              nLatency;           // Latency of the plugin: the maximum latency of return paths
+
+                mix::ParamExchange  sParams;            // Gain parameters published by control threads
+                bool                bBypass;            // Bypass is enabled
+                mix::SceneBank      sScenes;            // Stored scenes
+                SceneSync           sSceneSync;         // Exchange of scenes with the KVT storage
+                scene_gains_t       vFade[2];           // Gains at the start and at the end of the scene crossfade
+                size_t              nFadePos;           // Current position of the scene crossfade
+                size_t              nFadeLength;        // Length of the scene crossfade, zero if not active
+                uint32_t            nSceneSave;         // Scenes to be written to KVT
+                ssize_t             nSceneNames;        // Scene to restore channel names from, negative if none
+                bool                bSceneLoad;         // Scenes should be read from KVT
+                bool                bSceneStore;        // State of the store trigger
+                bool                bSceneRecall;       // State of the recall trigger
 
                 plug::IPort        *pBypass;            // Bypass switch
                 plug::IPort        *pMonoOut;           // Mono output
                 plug::IPort        *pBalance;           // Balance control
+                plug::IPort        *pThreads;           // Number of processing threads
+                plug::IPort        *pMtBlock;           // Minimum block size for parallel processing
+                plug::IPort        *vVcas[meta::mixer::VCAS];  // VCA group gains
+                plug::IPort        *pProfile;           // DSP load profiling switch
+                plug::IPort        *vProfMeters[PS_COUNT];  // DSP load meters of stages
+                plug::IPort        *pLoudness;          // Loudness metering switch
+                plug::IPort        *pScene;             // Scene slot
+                plug::IPort        *pSceneStore;        // Store scene trigger
+                plug::IPort        *pSceneRecall;       // Recall scene trigger
+                plug::IPort        *pSceneFade;         // Scene crossfade time
+                loudness_t          sLoudness;          // Loudness meters of the master bus
 
                 uint8_t            *pData;              // Allocated data
 
+            protected:
+                static size_t       select_tile_size(size_t channels);
+                static void         init_loudness(loudness_t *l);
+                static void         dump_loudness(dspu::IStateDumper *v, const char *name, const loudness_t *l);
+
             protected:
                 void                do_destroy();
+                void                clear_strips();
+                void                bind_buffers(size_t samples);
+                void                output_meters();
+                void                build_routes();
+                bool                read_channel(mix_channel_t *c);
+                void                read_master();
+                void                update_strip(size_t first, bool has_solo);
+                void                update_gains(bool renew);
+                void                apply_params();
+                void                store_scene(size_t scene);
+                bool                recall_scene(size_t scene);
+                void                capture_gains(scene_gains_t *g);
+                void                pin_strip_fade(size_t first);
+                void                pin_master_fade();
+                void                advance_fade(size_t samples);
+                void                sync_scenes();
+                void                delay_strips(size_t count);
+                void                delay_primary(size_t count);
+                inline bool         bus_active(size_t bus) const;
+                void                clear_buses(float * const *bus, size_t count);
+                void                prepare_ramp(size_t count);
+                inline const float *ramp(size_t count) const;
+                void                meter_mono_strips(const size_t *list, size_t n, size_t offset, size_t count);
+                void                meter_stereo_strips(const size_t *list, size_t n, size_t offset, size_t count);
+                void                mix_subgroups(size_t count);
+                void                mix_dry_wet(float *dst, const float *wet, primary_channel_t *c, size_t count);
+                void                mix_mono_master(size_t count);
+                void                mix_stereo_master(size_t count);
+                void                aux_stage(size_t count);
+                void                reduce_buses(size_t offset, size_t count);
+                void                bind_strip_meters();
+                void                meter_strips(size_t count);
+                void                meter_buses(size_t count);
+                void                output_loudness(const loudness_t *l, const mix::MeterBank *bank, size_t first, size_t n, float gain);
+                void                reset_profile();
+                void                update_profile(size_t samples);
+                inline uint64_t     prof_start() const;
+                inline uint64_t     prof_stop(size_t stage, uint64_t start);
+                inline uint64_t     prof_strip(size_t channel, uint64_t start) const;
+                inline void         renew_strip(size_t channel);
+
+                // Template parameters specify the number of primary channels (P) and strips (N),
+                // zero means that the actual value is known at run time only
+                template <size_t N>
+                void                mix_mono_strips(float * const *bus, const route_t *routes, size_t n, size_t offset, size_t count);
+                template <size_t N>
+                void                mix_stereo_strips(float * const *bus, const route_t *routes, size_t n, size_t offset, size_t count);
+                template <size_t P, size_t N>
+                uint64_t            mix_strips(size_t count);
+                template <size_t P>
+                void                mix_master(size_t count);
+                template <size_t P>
+                void                output_stage(size_t count);
+                template <size_t P>
+                void                advance_primary(size_t count);
+                template <size_t N>
+                void                advance_strips(size_t count);
+                template <size_t P, size_t N>
+                static void         process_job(void *arg, size_t job, size_t worker);
+                template <size_t P, size_t N>
+                void                process_parallel(size_t samples);
+                template <size_t P, size_t N>
+                void                process_tiles(size_t samples);
 
             public:
-                explicit mixer(const meta::plugin_t *meta);
+                /**
+                 * Create mixer
+                 * @param meta plugin metadata
+                 * @param p_channels number of primary channels (1 for mono, 2 for stereo)
+                 * @param m_channels number of mixer input channels (two per each stereo strip)
+                 */
+                explicit mixer(const meta::plugin_t *meta, size_t p_channels, size_t m_channels);
                 virtual ~mixer() override;
 
                 virtual void        init(plug::IWrapper *wrapper, plug::IPort **ports) override;
@@ -116,8 +441,32 @@ namespace lsp
             public:
                 virtual void        update_sample_rate(long sr) override;
                 virtual void        update_settings() override;
+                virtual void        state_loaded() override;
                 virtual void        process(size_t samples) override;
                 virtual void        dump(dspu::IStateDumper *v) const override;
+
+            public:
+                /**
+                 * Get the exchange of gain parameters: values may be published from any thread
+                 * and are applied at the start of the next processing block
+                 * @return parameter exchange
+                 */
+                inline mix::ParamExchange  *params()                                { return &sParams; }
+
+                /**
+                 * Get the index of the strip parameter in the parameter exchange
+                 * @param strip strip number starting with 0
+                 * @param param strip parameter
+                 * @return index of the parameter
+                 */
+                inline size_t       strip_param(size_t strip, size_t param) const   { return strip * SP_COUNT + param; }
+
+                /**
+                 * Get the index of the master section parameter in the parameter exchange
+                 * @param param master section parameter
+                 * @return index of the parameter
+                 */
+                inline size_t       master_param(size_t param) const                { return (nMChannels / nPChannels) * SP_COUNT + param; }
         };
     } /* namespace plugins */
 } /* namespace lsp */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_MIXER_DELAYS_H_
+#define PRIVATE_PLUGINS_MIXER_DELAYS_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        namespace mix
+        {
+            /**
+             * Set of delay lines which share one memory arena.
+             *
+             * Each line is a ring buffer with the head of the ring mirrored past its end,
+             * so the delayed data of any span is contiguous in memory and is read by the
+             * consumer directly from the line without copying. The line is written only
+             * while its delay is non-zero, the consumer reads the source for other lines.
+             */
+            class DelayArena
+            {
+                private:
+                    DelayArena & operator = (const DelayArena &);
+                    DelayArena(const DelayArena &);
+
+                protected:
+                    typedef struct line_t
+                    {
+                        float              *vData;                  // Ring buffer with mirrored head
+                        size_t              nCapacity;              // Maximum delay in samples
+                        size_t              nLength;                // Length of the ring in samples
+                        size_t              nHead;                  // Write position
+                        size_t              nDelay;                 // Current delay in samples
+                    } line_t;
+
+                protected:
+                    line_t             *vLines;                     // Delay lines
+                    size_t              nLines;                     // Number of delay lines
+                    size_t              nSpan;                      // Maximum number of samples processed at once
+
+                    uint8_t            *pLines;                     // Allocated line descriptors
+                    uint8_t            *pData;                      // Allocated arena
+
+                public:
+                    explicit DelayArena();
+                    ~DelayArena();
+
+                public:
+                    /**
+                     * Initialize the set of delay lines, does not allocate the arena
+                     * @param lines number of delay lines
+                     * @param span maximum number of samples processed at once
+                     * @return status of operation
+                     */
+                    status_t            init(size_t lines, size_t span);
+
+                    /**
+                     * Destroy the set of delay lines and the arena
+                     */
+                    void                destroy();
+
+                    /**
+                     * Set the maximum delay of the line, takes effect after the arena is reallocated
+                     * @param line line number
+                     * @param capacity maximum delay in samples
+                     */
+                    void                set_capacity(size_t line, size_t capacity);
+
+                    /**
+                     * Reallocate the arena for current capacities of all lines, clears all lines
+                     * @return status of operation
+                     */
+                    status_t            allocate();
+
+                    /**
+                     * Clear all lines
+                     */
+                    void                clear();
+
+                    /**
+                     * Set the delay of the line, the line is cleared when it gets enabled
+                     * @param line line number
+                     * @param delay delay in samples, limited by the capacity of the line
+                     */
+                    void                set_delay(size_t line, size_t delay);
+
+                    /**
+                     * Get the delay of the line
+                     * @param line line number
+                     * @return delay in samples
+                     */
+                    inline size_t       delay(size_t line) const    { return vLines[line].nDelay; }
+
+                    /**
+                     * Push the data to the line and obtain the delayed data
+                     * @param line line number
+                     * @param src source data
+                     * @param count number of samples, at most the span of the arena
+                     * @return pointer to count samples of delayed data, valid until the next call
+                     *   for the same line; NULL if the delay of the line is zero
+                     */
+                    float              *process(size_t line, const float *src, size_t count);
+
+                    void                dump(dspu::IStateDumper *v) const;
+            };
+
+        } /* namespace mix */
+    } /* namespace plugins */
+} /* namespace lsp */
+
+
+#endif /* PRIVATE_PLUGINS_MIXER_DELAYS_H_ */
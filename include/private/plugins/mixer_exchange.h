@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_MIXER_EXCHANGE_H_
+#define PRIVATE_PLUGINS_MIXER_EXCHANGE_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        namespace mix
+        {
+            /**
+             * Wait-free exchange of parameter values between control threads and the processing thread.
+             * Writers change values in the private copy and publish all values at once into the
+             * triple buffer, the processing thread takes the latest published values without waiting.
+             * Each value carries the serial number of the change, so the processing thread applies
+             * only values changed since the last take, including changes of publications it has missed.
+             * Only one writer may change values at a time, other writers fail instead of waiting.
+             */
+            class ParamExchange
+            {
+                private:
+                    ParamExchange & operator = (const ParamExchange &);
+                    ParamExchange(const ParamExchange &);
+
+                protected:
+                    typedef struct slot_t
+                    {
+                        float              *vValue;             // Parameter values
+                        uint32_t           *vSerial;            // Serial numbers of parameter changes
+                    } slot_t;
+
+                protected:
+                    slot_t              vSlots[3];          // Slots of the triple buffer
+                    slot_t              sShadow;            // Values changed by writers
+                    uint32_t           *vTaken;             // Serial numbers of values taken by the reader
+                    size_t              nParams;            // Number of parameters
+                    size_t              nBack;              // Slot owned by the writer
+                    size_t              nFront;             // Slot owned by the reader
+                    uatomic_t           nMiddle;            // Published slot and the flag of the new publication
+                    uatomic_t           nWriter;            // The writer is active
+
+                    uint8_t            *pData;              // Allocated data
+
+                public:
+                    explicit ParamExchange();
+                    ~ParamExchange();
+
+                public:
+                    /**
+                     * Initialize the exchange, all values are set to zero
+                     * @param params number of parameters
+                     * @return status of operation
+                     */
+                    status_t            init(size_t params);
+
+                    /**
+                     * Destroy the exchange
+                     */
+                    void                destroy();
+
+                    /**
+                     * Get the number of parameters
+                     * @return number of parameters
+                     */
+                    inline size_t       size() const                    { return nParams; }
+
+                public:
+                    /**
+                     * Start changing values, may be called from any thread
+                     * @return true if the caller became the writer, false if another writer is active
+                     */
+                    bool                begin();
+
+                    /**
+                     * Change the parameter value, should be called by the writer only
+                     * @param index parameter index
+                     * @param value parameter value
+                     */
+                    void                set(size_t index, float value);
+
+                    /**
+                     * Get the parameter value last set by writers, should be called by the writer only
+                     * @param index parameter index
+                     * @return parameter value
+                     */
+                    inline float        get(size_t index) const         { return sShadow.vValue[index]; }
+
+                    /**
+                     * Publish changed values to the processing thread and stop being the writer
+                     */
+                    void                publish();
+
+                public:
+                    /**
+                     * Obtain the latest published values, should be called by the processing thread only
+                     * @return true if new values have been published since the last call
+                     */
+                    bool                fetch();
+
+                    /**
+                     * Take the value obtained by fetch() if it has changed since the last take,
+                     * should be called by the processing thread only
+                     * @param index parameter index
+                     * @param value pointer to store the value
+                     * @return true if the value has changed
+                     */
+                    bool                take(size_t index, float *value);
+
+                    void                dump(dspu::IStateDumper *v) const;
+            };
+
+        } /* namespace mix */
+    } /* namespace plugins */
+} /* namespace lsp */
+
+
+#endif /* PRIVATE_PLUGINS_MIXER_EXCHANGE_H_ */
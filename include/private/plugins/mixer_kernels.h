@@ -0,0 +1,312 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_MIXER_KERNELS_H_
+#define PRIVATE_PLUGINS_MIXER_KERNELS_H_
+
+#include <lsp-plug.in/common/types.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Fused processing kernels used by the mixer plugin series
+         */
+        namespace mix
+        {
+            static constexpr size_t TAPS_MAX    = 8;    // Maximum number of taps of the bus summation kernel
+            static constexpr size_t OUTPUTS_MAX = 8;    // Maximum number of outputs processed by one pass of the spread kernel
+
+            /**
+             * Single input of the bus summation kernel
+             */
+            typedef struct source_t
+            {
+                const float    *vData;          // Source buffer
+                float           fOldGain;       // Gain at the beginning of the block
+                float           fGain;          // Gain at the end of the block
+                float           fPre;           // Weight of the source in the pre-fader signal
+            } source_t;
+
+            /**
+             * Additional destination of the bus summation kernel which receives
+             * either the pre-fader or the post-fader (intermediate) signal
+             */
+            typedef struct tap_t
+            {
+                float          *vData;          // Destination buffer
+                float           fOldGain;       // Tap gain at the beginning of the block
+                float           fGain;          // Tap gain at the end of the block
+                bool            bPre;           // Take the pre-fader signal instead of the intermediate one
+            } tap_t;
+
+            /**
+             * Ramped 2x2 gain matrix of the stereo pair, the element [j][k] is the gain
+             * of the k-th input channel in the j-th output channel. Panning, balance and
+             * mono fold-down are all expressed as the matrix
+             */
+            typedef struct matrix_t
+            {
+                float           fOldGain[2][2]; // Gains at the beginning of the block
+                float           fGain[2][2];    // Gains at the end of the block
+            } matrix_t;
+
+            /**
+             * Output of the spread kernel
+             */
+            typedef struct output_t
+            {
+                float          *vData;          // Destination buffer
+                float           fOldGain;       // Gain at the beginning of the block
+                float           fGain;          // Gain at the end of the block
+            } output_t;
+
+            /**
+             * State of the bypass crossfade of the output, the gain is the weight
+             * of the unprocessed signal in the output
+             */
+            typedef struct xfade_t
+            {
+                float           fGain;          // Current weight of the unprocessed signal
+                float           fTarget;        // Target weight: 0 for the processed signal, 1 for bypass
+                float           fDelta;         // Change of the weight per sample
+            } xfade_t;
+
+            /**
+             * Loudspeaker of the horizontal surround layout
+             */
+            typedef struct speaker_t
+            {
+                size_t          nChannel;       // Index of the bus channel fed by the speaker
+                float           fAzimuth;       // Azimuth in degrees, positive values are to the right
+            } speaker_t;
+
+            /**
+             * All gain transitions within the block share the same normalized ramp shape
+             * built once per block length by ramp_shape(), the linear ramp between gains
+             * is expressed as one multiply-add against the shared shape:
+             *   lramp(a, b)[i] = a + (b - a) * ramp[i]
+             *
+             * Results differ from the ramp generated per call at most by the rounding
+             * of the gain delta, that is, by about |b - a| * 2^-23 relative to the signal.
+             * Kernels do not access the ramp shape if gains have not changed within the block.
+             *
+             * @param dst destination buffer to store the ramp shape
+             * @param count length of the block
+             */
+            void        ramp_shape(float *dst, size_t count);
+
+            /**
+             * Mix the set of sources into the bus and compute the peak of the intermediate signal.
+             * Selects the ramping kernel only if any of gains has changed within the block,
+             * otherwise the constant-gain kernel is used.
+             *
+             * @param dst destination bus to add data
+             * @param src list of sources
+             * @param n number of sources
+             * @param old_post post-gain at the beginning of the block
+             * @param post post-gain at the end of the block
+             * @param ramp ramp shape of the block, see ramp_shape()
+             * @param count number of samples to process
+             * @return maximum absolute value of the intermediate signal
+             */
+            float       bus_add(float *dst, const source_t *src, size_t n, float old_post, float post, const float *ramp, size_t count);
+
+            /**
+             * Mix the set of sources into the bus and additionally accumulate the pre-fader or
+             * the intermediate signal into the list of taps in the same pass:
+             *   s[i]       = sum { src[k].vData[i] * lramp(src[k].fOldGain, src[k].fGain) }
+             *   u[i]       = sum { src[k].vData[i] * src[k].fPre }
+             *   dst[i]     = dst[i] + s[i] * lramp(old_post, post)
+             *   tap[i]     = tap[i] + ((tap.bPre) ? u[i] : s[i]) * lramp(tap.fOldGain, tap.fGain)
+             *
+             * @param dst destination bus to add data
+             * @param src list of sources
+             * @param n number of sources
+             * @param old_post post-gain at the beginning of the block
+             * @param post post-gain at the end of the block
+             * @param taps list of taps
+             * @param nt number of taps, at most TAPS_MAX
+             * @param ramp ramp shape of the block, see ramp_shape()
+             * @param count number of samples to process
+             * @return maximum absolute value of the intermediate signal
+             */
+            float       bus_add_taps(float *dst, const source_t *src, size_t n, float old_post, float post,
+                                     const tap_t *taps, size_t nt, const float *ramp, size_t count);
+
+            /**
+             * Mix the stereo pair into the stereo bus through the gain matrix and additionally
+             * accumulate the unpanned input or the intermediate signal of each output into
+             * the taps. Each input buffer is read once for both outputs:
+             *   a[j][i]    = src[j][i] + src[j + 2][i]
+             *   s[j][i]    = a[0][i] * lramp(m.fOldGain[j][0], m.fGain[j][0]) + a[1][i] * lramp(m.fOldGain[j][1], m.fGain[j][1])
+             *   dst[j][i]  = dst[j][i] + s[j][i] * lramp(old_post[j], post[j])
+             *   tap[i]     = tap[i] + ((tap.bPre) ? a[j][i] : s[j][i]) * lramp(tap.fOldGain, tap.fGain), tap = taps[k*2 + j]
+             *
+             * @param dst left and right destination buses
+             * @param src left and right inputs followed by left and right returns, returns may be NULL
+             * @param m gain matrix
+             * @param old_post post-gains of outputs at the beginning of the block
+             * @param post post-gains of outputs at the end of the block
+             * @param taps pairs of left and right taps, the bPre flag of the left tap applies to the pair
+             * @param nt number of tap pairs, at most TAPS_MAX
+             * @param ramp ramp shape of the block, see ramp_shape()
+             * @param count number of samples to process
+             * @param peak maximum absolute values of intermediate signals of outputs
+             */
+            void        matrix_add_taps(float * const *dst, const float * const *src, const matrix_t *m,
+                                        const float *old_post, const float *post, const tap_t *taps, size_t nt,
+                                        const float *ramp, size_t count, float *peak);
+
+            /**
+             * Apply the gain matrix to the stereo pair, the destination may be the same as the source:
+             *   dst[j][i]  = src[0][i] * lramp(m.fOldGain[j][0], m.fGain[j][0]) + src[1][i] * lramp(m.fOldGain[j][1], m.fGain[j][1])
+             *
+             * @param dst left and right destination buffers
+             * @param src left and right source buffers
+             * @param m gain matrix
+             * @param ramp ramp shape of the block, see ramp_shape()
+             * @param count number of samples to process
+             */
+            void        matrix_apply(float * const *dst, const float * const *src, const matrix_t *m, const float *ramp, size_t count);
+
+            /**
+             * Apply gain to the source buffer and store result to the destination buffer,
+             * the linear ramp is applied only if the gain has changed:
+             *   dst[i]     = src[i] * lramp(old_gain, gain)
+             *
+             * @param dst destination buffer
+             * @param src source buffer
+             * @param old_gain gain at the beginning of the block
+             * @param gain gain at the end of the block
+             * @param ramp ramp shape of the block, see ramp_shape()
+             * @param count number of samples to process
+             */
+            void        copy_gain(float *dst, const float *src, float old_gain, float gain, const float *ramp, size_t count);
+
+            /**
+             * Mix the processed signal, the input and the return of the output channel in one pass,
+             * the linear ramp is applied only if any of gains has changed:
+             *   dst[i]     = wet[i] * lramp(old_gain[0], gain[0]) +
+             *                in[i] * lramp(old_gain[1], gain[1]) +
+             *                ret[i] * lramp(old_gain[2], gain[2])
+             *
+             * @param dst destination buffer, may be the same as the processed signal
+             * @param wet processed signal
+             * @param in input buffer
+             * @param ret return buffer, may be NULL
+             * @param old_gain gains of the processed signal, the input and the return at the beginning of the block
+             * @param gain gains of the processed signal, the input and the return at the end of the block
+             * @param ramp ramp shape of the block, see ramp_shape()
+             * @param count number of samples to process
+             */
+            void        dry_wet(float *dst, const float *wet, const float *in, const float *ret,
+                                const float *old_gain, const float *gain, const float *ramp, size_t count);
+
+            /**
+             * Perform the final stage of the output channel in one pass: bypass crossfade,
+             * copy to the send and metering of the input and the processed signal:
+             *   x[i]       = in[i] + ret[i]
+             *   out[i]     = wet[i] + (x[i] - wet[i]) * k[i]
+             *   send[i]    = out[i]
+             * where k[i] is the weight of the crossfade advancing towards the target by
+             * xf.fDelta per sample. The output buffer may be the same as the input or
+             * the return buffer, the in-place output is not written while the bypassed
+             * signal is equal to the input.
+             *
+             * @param out output buffer
+             * @param send send buffer, may be NULL
+             * @param in input buffer
+             * @param ret return buffer, may be NULL
+             * @param wet processed signal
+             * @param xf state of the bypass crossfade, updated by the call
+             * @param count number of samples to process
+             * @param peak maximum absolute values of the input (x) and the processed signal (wet)
+             */
+            void        output_pass(float *out, float *send, const float *in, const float *ret, const float *wet,
+                                    xfade_t *xf, size_t count, float *peak);
+
+            /**
+             * Replace gains with absolute value below the threshold by exact zero:
+             *   dst[i]     = (|dst[i]| < threshold) ? 0 : dst[i]
+             *
+             * @param dst gains to process
+             * @param threshold threshold
+             * @param count number of gains
+             */
+            void        snap_gains(float *dst, float threshold, size_t count);
+
+            /**
+             * Apply panning and balance to the gains of channels of stereo strips,
+             * the source gain of each channel is taken from the left gain:
+             *   right[i]   = left[i] * ((0.5 + pan[i]) * (1 + bal[i]))
+             *   left[i]    = left[i] * ((0.5 - pan[i]) * (1 - bal[i]))
+             *
+             * @param left gains of channels to the left output
+             * @param right gains of channels to the right output
+             * @param pan panning of channels in range [-0.5, 0.5]
+             * @param bal balance of strips in range [-1, 1]
+             * @param count number of channels
+             */
+            void        pan_gains(float *left, float *right, const float *pan, const float *bal, size_t count);
+
+            /**
+             * Mix the mono source into the set of outputs in one pass and compute the peak
+             * of the intermediate (post-fader) signal. Each input sample is read once
+             * for all outputs:
+             *   s[i]       = src[i] * lramp(old_gain, gain)
+             *   dst[i]     = dst[i] + s[i] * lramp(dst.fOldGain, dst.fGain)
+             *
+             * @param src source buffer
+             * @param old_gain fader gain at the beginning of the block
+             * @param gain fader gain at the end of the block
+             * @param dst list of outputs
+             * @param n number of outputs
+             * @param ramp ramp shape of the block, see ramp_shape()
+             * @param count number of samples to process
+             * @return maximum absolute value of the intermediate signal
+             */
+            float       spread_add(const float *src, float old_gain, float gain, const output_t *dst, size_t n,
+                                   const float *ramp, size_t count);
+
+            /**
+             * Compute the gains of the source panned over the horizontal loudspeaker layout
+             * with vector base amplitude panning (VBAP). The source is panned between the pair
+             * of adjacent speakers enclosing it, the gains are normalized to the constant power.
+             * The divergence spreads the power of the source uniformly over all speakers:
+             *   g[k]       = sqrt((1 - divergence) * vbap[k]^2 + divergence / n)
+             * Only the gains of channels fed by speakers are written.
+             *
+             * @param dst gains of bus channels, indexed by speaker_t::nChannel
+             * @param spk list of speakers sorted by azimuth in ascending order
+             * @param n number of speakers
+             * @param azimuth azimuth of the source in degrees
+             * @param divergence divergence in range [0, 1]
+             */
+            void        vbap_gains(float *dst, const speaker_t *spk, size_t n, float azimuth, float divergence);
+
+        } /* namespace mix */
+    } /* namespace plugins */
+} /* namespace lsp */
+
+
+#endif /* PRIVATE_PLUGINS_MIXER_KERNELS_H_ */
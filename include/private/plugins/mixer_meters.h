@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_MIXER_METERS_H_
+#define PRIVATE_PLUGINS_MIXER_METERS_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        namespace mix
+        {
+            /**
+             * Bank of RMS, loudness (ITU-R BS.1770) and true peak meters for many channels.
+             *
+             * Channels are processed in groups of LANES channels. The state of the group is
+             * interleaved by lanes, so the per-sample loops over lanes of the K-weighting
+             * filters and the true peak interpolator map onto SIMD registers. The true peak
+             * interpolator is performed only for blocks of samples which may exceed both the
+             * peak already measured in the bucket and the clipping-safe threshold, below
+             * the threshold the true peak meter shows the sample peak.
+             *
+             * All measurement windows consist of fixed-size buckets of energy updated with
+             * running sums, so the meter ballistics do not depend on the block size.
+             * Groups are processed independently and may be distributed between threads,
+             * the bank state advances by the commit() call after all groups are processed.
+             */
+            class MeterBank
+            {
+                public:
+                    static constexpr size_t LANES           = 4;        // Number of channels processed together
+                    static constexpr size_t TP_FACTOR       = 4;        // Oversampling factor of the true peak meter
+                    static constexpr size_t TP_TAPS         = 12;       // Number of taps of each interpolator phase
+                    static constexpr size_t RING_SIZE       = 300;      // Number of buckets in the longest window
+                    static constexpr size_t RMS_BUCKETS     = 30;       // Number of buckets in the RMS window
+                    static constexpr size_t M_BUCKETS       = 40;       // Number of buckets in the momentary loudness window
+                    static constexpr size_t S_BUCKETS       = RING_SIZE;// Number of buckets in the short-term loudness window
+
+                private:
+                    MeterBank & operator = (const MeterBank &);
+                    MeterBank(const MeterBank &);
+
+                protected:
+                    typedef struct group_t
+                    {
+                        float               vPre[2][LANES];         // State of the K-weighting pre-filter
+                        float               vRlb[2][LANES];         // State of the K-weighting RLB filter
+                        float               vHist[TP_TAPS - 1][LANES];  // History of the true peak interpolator
+                        float               vK[LANES];              // K-weighted energy of the current bucket
+                        float               vR[LANES];              // Energy of the current bucket
+                        float               vPeak[LANES];           // True peak of the current bucket
+                        double              vSumM[LANES];           // K-weighted energy of the momentary window
+                        double              vSumS[LANES];           // K-weighted energy of the short-term window
+                        double              vSumR[LANES];           // Energy of the RMS window
+                        float              *vRingK;                 // K-weighted energies of buckets
+                        float              *vRingR;                 // Energies of buckets
+                        float              *vRingP;                 // True peaks of buckets
+                        const float        *vSrc[LANES][2];         // Sources summed into each channel
+                    } group_t;
+
+                    typedef struct biquad_t
+                    {
+                        float               b0, b1, b2;
+                        float               a1, a2;
+                    } biquad_t;
+
+                protected:
+                    group_t            *vGroups;                    // Channel groups
+                    size_t              nChannels;                  // Number of channels
+                    size_t              nGroups;                    // Number of channel groups
+                    size_t              nBucketSize;                // Size of the bucket in samples
+                    size_t              nBucketFill;                // Number of samples in the current bucket
+                    size_t              nPos;                       // Ring position of the current bucket
+                    biquad_t            sPre;                       // K-weighting pre-filter (high shelf)
+                    biquad_t            sRlb;                       // K-weighting RLB filter (high pass)
+                    float               vTpFir[TP_FACTOR][TP_TAPS]; // Polyphase true peak interpolator
+                    float               fTpGain;                    // Maximum gain of the interpolator phase over the peak of taps
+                    bool                bTruePeak;                  // Measure the true peak instead of the sample peak
+
+                    uint8_t            *pData;                      // Allocated data
+
+                protected:
+                    void                process_segment(group_t *g, size_t offset, size_t count);
+                    void                measure_true_peak(const float (*x)[LANES], size_t count, float *pk) const;
+                    void                close_bucket(group_t *g, size_t pos);
+
+                public:
+                    explicit MeterBank();
+                    ~MeterBank();
+
+                public:
+                    /**
+                     * Initialize the bank
+                     * @param channels number of channels
+                     * @param true_peak measure the true peak, otherwise the peak meter measures the sample peak
+                     * @return status of operation
+                     */
+                    status_t            init(size_t channels, bool true_peak);
+
+                    /**
+                     * Destroy the bank
+                     */
+                    void                destroy();
+
+                    /**
+                     * Set sample rate, resets the state of all meters
+                     * @param sr sample rate
+                     */
+                    void                set_sample_rate(size_t sr);
+
+                    /**
+                     * Reset the state of all meters
+                     */
+                    void                clear();
+
+                    /**
+                     * Get number of channel groups
+                     * @return number of channel groups
+                     */
+                    inline size_t       groups() const      { return nGroups; }
+
+                    /**
+                     * Bind sources to the channel, the channel measures the sum of sources
+                     * @param channel channel number
+                     * @param a first source, NULL for silent channel
+                     * @param b second source, may be NULL
+                     */
+                    void                bind(size_t channel, const float *a, const float *b);
+
+                    /**
+                     * Process the range of channel groups, does not advance the bank state.
+                     * Different ranges of groups may be processed by different threads.
+                     * @param first first group to process
+                     * @param n number of groups to process
+                     * @param offset offset of the data in bound sources
+                     * @param count number of samples to process
+                     */
+                    void                process(size_t first, size_t n, size_t offset, size_t count);
+
+                    /**
+                     * Advance the bank state after all groups have been processed
+                     * @param count number of processed samples
+                     */
+                    void                commit(size_t count);
+
+                    /**
+                     * Get the RMS level of the channel
+                     * @param channel channel number
+                     * @return RMS level
+                     */
+                    float               rms(size_t channel) const;
+
+                    /**
+                     * Get the mean square of the K-weighted signal over the momentary (400 ms) window
+                     * @param channel channel number
+                     * @return mean square of the K-weighted signal
+                     */
+                    float               momentary(size_t channel) const;
+
+                    /**
+                     * Get the mean square of the K-weighted signal over the short-term (3 s) window
+                     * @param channel channel number
+                     * @return mean square of the K-weighted signal
+                     */
+                    float               short_term(size_t channel) const;
+
+                    /**
+                     * Get the true peak (or the sample peak if the bank does not measure the true peak)
+                     * of the channel over the momentary window
+                     * @param channel channel number
+                     * @return true peak level
+                     */
+                    float               true_peak(size_t channel) const;
+
+                    /**
+                     * Convert the sum of mean squares of K-weighted channels to the loudness
+                     * expressed as a gain value relative to 0 LUFS
+                     * @param ms sum of mean squares
+                     * @return loudness
+                     */
+                    static float        loudness(float ms);
+
+                    void                dump(dspu::IStateDumper *v) const;
+            };
+
+        } /* namespace mix */
+    } /* namespace plugins */
+} /* namespace lsp */
+
+
+#endif /* PRIVATE_PLUGINS_MIXER_METERS_H_ */
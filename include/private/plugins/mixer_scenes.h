@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_MIXER_SCENES_H_
+#define PRIVATE_PLUGINS_MIXER_SCENES_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/dsp-units/iface/IStateDumper.h>
+#include <private/meta/mixer.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        namespace mix
+        {
+            /**
+             * Mix settings of the mixer channel
+             */
+            typedef struct strip_settings_t
+            {
+                float               fGain;                              // Fader gain
+                float               fPan;                               // Panning
+                float               fBalance;                           // Balance
+                float               vSend[meta::mixer::AUX_BUSES];      // Aux send levels
+                uint32_t            nVca;                               // VCA group assignment
+                uint32_t            nGroup;                             // Subgroup assignment
+                bool                bSolo;                              // Solo flag
+                bool                bMute;                              // Mute flag
+                bool                bPhase;                             // Phase invert flag
+            } strip_settings_t;
+
+            /**
+             * Mix settings of the master section
+             */
+            typedef struct master_settings_t
+            {
+                float               fDry;                               // Dry signal amount
+                float               fWet;                               // Wet signal amount
+                float               fOutGain;                           // Output gain
+                float               fBalance;                           // Output balance
+                float               vVca[meta::mixer::VCAS];            // VCA group gains
+                float               vGroupGain[meta::mixer::SUBGROUPS]; // Subgroup gains
+                float               vAuxGain[meta::mixer::AUX_BUSES];   // Aux bus gains
+                bool                bMonoOut;                           // Mono output
+                bool                vGroupMute[meta::mixer::SUBGROUPS]; // Subgroup mute flags
+                bool                vAuxPre[meta::mixer::AUX_BUSES];    // Aux pre-fader tap flags
+            } master_settings_t;
+
+            /**
+             * Reset mix settings of the mixer channel to defaults
+             * @param s settings to reset
+             */
+            void init_settings(strip_settings_t *s);
+
+            /**
+             * Reset mix settings of the master section to defaults
+             * @param m settings to reset
+             */
+            void init_settings(master_settings_t *m);
+
+            /**
+             * Dump mix settings of the mixer channel
+             * @param v state dumper
+             * @param name name of the object
+             * @param s settings to dump
+             */
+            void dump_settings(dspu::IStateDumper *v, const char *name, const strip_settings_t *s);
+
+            /**
+             * Dump mix settings of the master section
+             * @param v state dumper
+             * @param name name of the object
+             * @param m settings to dump
+             */
+            void dump_settings(dspu::IStateDumper *v, const char *name, const master_settings_t *m);
+
+            /**
+             * Storage of scenes: complete sets of mix settings of all mixer channels and
+             * the master section. Scenes are serialized to versioned little-endian blobs, a blob
+             * is accepted only if it has been produced for the same number of channels.
+             */
+            class SceneBank
+            {
+                private:
+                    SceneBank & operator = (const SceneBank &);
+                    SceneBank(const SceneBank &);
+
+                protected:
+                    strip_settings_t   *vStrips;                    // Settings of channels for all scenes
+                    master_settings_t  *vMaster;                    // Settings of the master section for all scenes
+                    bool               *vValid;                     // Scene has been stored
+                    uint8_t            *vBlob;                      // Serialized scene
+                    size_t              nScenes;                    // Number of scenes
+                    size_t              nChannels;                  // Number of mixer channels
+
+                    uint8_t            *pData;                      // Allocated data
+
+                public:
+                    explicit SceneBank();
+                    ~SceneBank();
+
+                public:
+                    /**
+                     * Initialize the storage, all scenes are empty
+                     * @param scenes number of scenes
+                     * @param channels number of mixer channels
+                     * @return status of operation
+                     */
+                    status_t            init(size_t scenes, size_t channels);
+
+                    /**
+                     * Destroy the storage
+                     */
+                    void                destroy();
+
+                    /**
+                     * Get the number of scenes
+                     * @return number of scenes
+                     */
+                    inline size_t       scenes() const                  { return nScenes; }
+
+                    /**
+                     * Check that the scene has been stored
+                     * @param scene scene number
+                     * @return true if the scene has been stored
+                     */
+                    inline bool         valid(size_t scene) const       { return vValid[scene]; }
+
+                    /**
+                     * Mark the scene as stored after its settings have been written
+                     * @param scene scene number
+                     */
+                    inline void         commit(size_t scene)            { vValid[scene] = true; }
+
+                    /**
+                     * Mark all scenes as empty
+                     */
+                    void                clear();
+
+                    /**
+                     * Copy the scene from another storage with the same number of channels
+                     * @param scene scene number
+                     * @param src storage to copy the scene from
+                     */
+                    void                copy(size_t scene, const SceneBank *src);
+
+                    /**
+                     * Exchange contents with another storage, no data is copied
+                     * @param src storage to exchange contents with
+                     */
+                    void                swap(SceneBank *src);
+
+                    /**
+                     * Get settings of mixer channels of the scene
+                     * @param scene scene number
+                     * @return settings of mixer channels
+                     */
+                    inline strip_settings_t    *strips(size_t scene)    { return &vStrips[scene * nChannels]; }
+
+                    /**
+                     * Get settings of the master section of the scene
+                     * @param scene scene number
+                     * @return settings of the master section
+                     */
+                    inline master_settings_t   *master(size_t scene)    { return &vMaster[scene]; }
+
+                    /**
+                     * Get the size of the serialized scene
+                     * @return size of the serialized scene in bytes
+                     */
+                    size_t              blob_size() const;
+
+                    /**
+                     * Serialize the stored scene
+                     * @param scene scene number
+                     * @return pointer to blob_size() bytes of serialized scene, valid until the next call
+                     */
+                    const void         *serialize(size_t scene);
+
+                    /**
+                     * Restore the scene from the serialized data
+                     * @param scene scene number
+                     * @param data serialized scene
+                     * @param size size of serialized scene in bytes
+                     * @return true if the scene has been restored
+                     */
+                    bool                deserialize(size_t scene, const void *data, size_t size);
+
+                    void                dump(dspu::IStateDumper *v) const;
+            };
+
+        } /* namespace mix */
+    } /* namespace plugins */
+} /* namespace lsp */
+
+
+#endif /* PRIVATE_PLUGINS_MIXER_SCENES_H_ */
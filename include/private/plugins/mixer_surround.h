@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_MIXER_SURROUND_H_
+#define PRIVATE_PLUGINS_MIXER_SURROUND_H_
+
+#include <lsp-plug.in/plug-fw/plug.h>
+#include <private/meta/mixer.h>
+#include <private/plugins/mixer_kernels.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        /**
+         * Mixer with mono strips panned over the 5.1 or 7.1 surround master bus
+         */
+        class mixer_surround: public plug::Module
+        {
+            private:
+                mixer_surround & operator = (const mixer_surround &);
+                mixer_surround (const mixer_surround &);
+
+            protected:
+                static constexpr size_t CHANNELS       = meta::mixer::SURROUND_CHANNELS;
+                static constexpr size_t LFE_CHANNEL    = 3;
+
+                typedef struct bus_channel_t
+                {
+                    mix::xfade_t        sBypass;        // Bypass crossfade
+
+                    float              *vIn;            // Input buffer pointer
+                    float              *vOut;           // Output buffer pointer
+                    float              *vWet;           // Bus buffer
+                    float               fInLevel;       // Input level
+                    float               fOutLevel;      // Output level
+
+                    plug::IPort        *pIn;            // Input data port
+                    plug::IPort        *pOut;           // Output data port
+                    plug::IPort        *pInLevel;       // Input level meter
+                    plug::IPort        *pOutLevel;      // Output level meter
+                } bus_channel_t;
+
+                typedef struct strip_t
+                {
+                    float              *vIn;            // Input buffer pointer
+                    float               fOldGain;       // Old fader gain
+                    float               fGain;          // Fader gain
+                    float               vOldPan[CHANNELS];  // Old gains of bus channels (after the fader)
+                    float               vPan[CHANNELS];     // Gains of bus channels (after the fader)
+                    uint8_t             vOutputs[CHANNELS]; // Bus channels the strip contributes to
+                    size_t              nOutputs;       // Number of bus channels the strip contributes to
+                    float               fOutLevel;      // Output level
+                    bool                bSolo;          // Solo flag
+
+                    plug::IPort        *pIn;            // Input data port
+                    plug::IPort        *pSolo;          // Solo switch
+                    plug::IPort        *pMute;          // Mute switch
+                    plug::IPort        *pPhase;         // Phase invert switch
+                    plug::IPort        *pAzimuth;       // Azimuth
+                    plug::IPort        *pDivergence;    // Divergence
+                    plug::IPort        *pLfe;           // LFE send
+                    plug::IPort        *pOutGain;       // Output gain
+                    plug::IPort        *pOutLevel;      // Output level meter
+                } strip_t;
+
+            protected:
+                bus_channel_t       vChannels[CHANNELS];    // Channels of the surround bus
+                strip_t            *vStrips;            // Mixer strips
+                size_t              nStrips;            // Number of strips
+                size_t              nLayout;            // Index of the surround layout
+                size_t              nTileSize;          // Size of the processing tile in samples
+                float               fOldDry;            // Old dry signal amount
+                float               fDry;               // Dry signal amount
+                float               fOldWet;            // Old wet signal amount
+                float               fWet;               // Wet signal amount
+                float              *vRamp[2];           // Ramp shapes of the full tile and of the shorter tile
+                size_t              nRampLength;        // Length of the ramp shape of the shorter tile
+                bool                bRebuild;           // Output lists should be rebuilt after the end of gain transition
+
+                plug::IPort        *pBypass;            // Bypass switch
+                plug::IPort        *pLayout;            // Surround layout
+                plug::IPort        *pDry;               // Dry signal amount
+                plug::IPort        *pWet;               // Wet signal amount
+                plug::IPort        *pOutGain;           // Output gain
+
+                uint8_t            *pData;              // Allocated data
+
+            protected:
+                void                do_destroy();
+                void                bind_buffers();
+                void                output_meters();
+                void                build_outputs();
+                void                prepare_ramp(size_t count);
+                inline const float *ramp(size_t count) const;
+                void                mix_strips(size_t count);
+                void                mix_master(size_t count);
+                void                output_stage(size_t count);
+                void                advance(size_t count);
+
+            public:
+                /**
+                 * Create surround mixer
+                 * @param meta plugin metadata
+                 * @param strips number of mixer strips
+                 */
+                explicit mixer_surround(const meta::plugin_t *meta, size_t strips);
+                virtual ~mixer_surround() override;
+
+                virtual void        init(plug::IWrapper *wrapper, plug::IPort **ports) override;
+                void                destroy() override;
+
+            public:
+                virtual void        update_sample_rate(long sr) override;
+                virtual void        update_settings() override;
+                virtual void        process(size_t samples) override;
+                virtual void        dump(dspu::IStateDumper *v) const override;
+        };
+    } /* namespace plugins */
+} /* namespace lsp */
+
+
+#endif /* PRIVATE_PLUGINS_MIXER_SURROUND_H_ */
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef PRIVATE_PLUGINS_MIXER_WORKERS_H_
+#define PRIVATE_PLUGINS_MIXER_WORKERS_H_
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/common/status.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/Thread.h>
+
+#if !defined(PLATFORM_WINDOWS) && !defined(PLATFORM_MACOSX)
+    #include <semaphore.h>
+#endif /* PLATFORM_WINDOWS */
+
+namespace lsp
+{
+    namespace plugins
+    {
+        namespace mix
+        {
+            /**
+             * Job function
+             * @param arg argument passed to the pool at initialization
+             * @param job index of the job in the batch
+             * @param worker index of the worker that executes the job, 0 is the calling thread
+             */
+            typedef void (* job_func_t)(void *arg, size_t job, size_t worker);
+
+            /**
+             * Pool of worker threads that execute batches of jobs together with the calling
+             * thread. All worker threads are spawned at initialization, the processing thread only
+             * selects the number of workers allowed to take jobs. Jobs are taken by threads from the
+             * shared lock-free ticket, so the calling thread completes the batch on its own if workers
+             * are not ready yet. Workers spin shortly after the batch and then sleep until the next
+             * batch wakes them up, the calling thread spins shortly waiting for the jobs taken by
+             * workers and then sleeps until the last of them completes. No memory allocation and
+             * no locking is performed while running the batch.
+             */
+            class WorkerPool
+            {
+                public:
+                    static constexpr size_t WORKERS_MAX     = 16;       // Maximum number of worker threads
+                    static constexpr size_t JOBS_MAX        = 0xff;     // Maximum number of jobs in the batch
+
+                private:
+                    /**
+                     * Counting semaphore used to wake up the sleeping worker, posting is real-time safe
+                     */
+                    class Wakeup
+                    {
+                        private:
+                        #if defined(PLATFORM_WINDOWS)
+                            void               *hSem;
+                        #elif defined(PLATFORM_MACOSX)
+                            void               *hSem;
+                        #else
+                            sem_t               hSem;
+                        #endif /* PLATFORM_WINDOWS */
+                            bool                bValid;
+
+                        public:
+                            explicit Wakeup();
+                            ~Wakeup();
+
+                        public:
+                            inline bool         valid() const   { return bValid; }
+                            void                post();
+                            void                wait();
+                    };
+
+                    class Worker: public ipc::Thread
+                    {
+                        private:
+                            friend class WorkerPool;
+
+                        private:
+                            WorkerPool     *pPool;
+                            size_t          nIndex;
+                            Wakeup          sWakeup;                // Wake-up event of the worker
+                            uatomic_t       nSleep;                 // The worker sleeps or is going to sleep on the event
+
+                        public:
+                            explicit Worker(WorkerPool *pool, size_t index);
+                            virtual ~Worker() override;
+
+                        public:
+                            virtual status_t run() override;
+                    };
+
+                private:
+                    WorkerPool & operator = (const WorkerPool &);
+                    WorkerPool(const WorkerPool &);
+
+                    friend class Worker;
+
+                private:
+                    Worker             *vWorkers[WORKERS_MAX];  // Worker threads
+                    size_t              nWorkers;               // Number of worker threads
+                    job_func_t          pFunc;                  // Job function
+                    void               *pArg;                   // Job function argument
+                    uint32_t            nSerial;                // Serial number of the last batch
+                    int                 nPolicy;                // Scheduling policy of the host thread
+                    int                 nPriority;              // Scheduling priority of the host thread
+                    bool                bPriority;              // Scheduling priority of the host thread has been captured
+                    Wakeup              sDone;                  // Wake-up event of the calling thread
+                    uatomic_t           nWaiting;               // The calling thread sleeps or is going to sleep on the event
+                    uatomic_t           nPrioSerial;            // Serial number of the captured scheduling priority
+                    uatomic_t           nTicket;                // Batch ticket: serial, number of jobs and next job
+                    uatomic_t           nDone;                  // Number of completed jobs in the batch
+                    uatomic_t           nActive;                // Number of workers allowed to take jobs
+                    uatomic_t           nExit;                  // Exit request for workers
+
+                private:
+                    void                execute(size_t worker);
+                    void                capture_priority();
+                    void                apply_priority();
+                    void                wait(size_t jobs);
+
+                public:
+                    explicit WorkerPool();
+                    ~WorkerPool();
+
+                public:
+                    /**
+                     * Bind the job function and spawn worker threads. Workers take the scheduling
+                     * priority of the processing thread when they take part in the first batch.
+                     * @param func job function
+                     * @param arg job function argument
+                     * @param workers number of worker threads to spawn, at most WORKERS_MAX
+                     * @return status of operation, the pool remains usable with the workers
+                     *   spawned before the error
+                     */
+                    status_t            init(job_func_t func, void *arg, size_t workers);
+
+                    /**
+                     * Stop and destroy all worker threads
+                     */
+                    void                destroy();
+
+                    /**
+                     * Get number of spawned worker threads
+                     * @return number of worker threads, not including the calling thread
+                     */
+                    inline size_t       workers() const     { return nWorkers; }
+
+                    /**
+                     * Get number of workers allowed to take jobs
+                     * @return number of active workers, not including the calling thread
+                     */
+                    inline size_t       active()            { return atomic_load(&nActive); }
+
+                    /**
+                     * Allow the specified number of workers to take jobs. Workers that are not
+                     * allowed to take jobs sleep until they are allowed. Real-time safe.
+                     * @param workers number of active workers, limited to the number of spawned workers
+                     */
+                    void                set_active(size_t workers);
+
+                    /**
+                     * Execute the batch of jobs and wait for its completion. The calling
+                     * thread takes jobs too. Real-time safe.
+                     * @param jobs number of jobs in the batch, at most JOBS_MAX
+                     */
+                    void                run(size_t jobs);
+            };
+
+        } /* namespace mix */
+    } /* namespace plugins */
+} /* namespace lsp */
+
+
+#endif /* PRIVATE_PLUGINS_MIXER_WORKERS_H_ */
@@ -24,6 +24,7 @@
 
 #include <lsp-plug.in/plug-fw/ui.h>
 #include <lsp-plug.in/lltl/darray.h>
+#include <lsp-plug.in/lltl/parray.h>
 
 namespace lsp
 {
@@ -37,6 +38,7 @@ namespace lsp
             protected:
                 typedef struct channel_t
                 {
+                    mixer                      *pUI;            // Owner of the channel
                     tk::Edit                   *wName;          // Edit that holds channel name
 
                     size_t                      nIndex;         // Channel index
@@ -45,6 +47,7 @@ namespace lsp
 
             protected:
                 lltl::darray<channel_t>     vChannels;          // List of channels
+                lltl::parray<channel_t>     vChanged;           // Channels with changed names to submit to KVT
 
             protected:
                 ui::IPort          *find_port(const char *prefix, size_t id);
@@ -54,6 +57,8 @@ namespace lsp
 
                 void                sync_channel_names(core::KVTStorage *kvt);
                 void                set_channel_name(core::KVTStorage *kvt, int id, const char *name);
+                channel_t          *kvt_channel(const char *id);
+                void                mark_name_changed(channel_t *c);
 
             protected:
                 static status_t     slot_channel_name_updated(tk::Widget *sender, void *ptr, void *data);
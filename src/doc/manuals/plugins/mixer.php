@@ -1,18 +1,22 @@
 <?php
 	plugin_header();
-	$m      =   ($PAGE == 'mixer_mono') ? 'm' : 's';
-	$nc     =   (strpos($PAGE, '_x16') > 0) ? '16' : (
-		        (strpos($PAGE, '_x8') > 0) ? '8' : '4');
+	$m      =   ($PAGE == 'mixer_mono') ? 'm' : (
+		        ($PAGE == 'mixer_surround') ? 'u' : 's');
+	$nc     =   (strpos($PAGE, '_x64') > 0) ? '64' : (
+		        (strpos($PAGE, '_x32') > 0) ? '32' : (
+		        (strpos($PAGE, '_x16') > 0) ? '16' : (
+		        (strpos($PAGE, '_x8') > 0) ? '8' : '4')));
 ?>
 
 <p>
-	This plugin performs mixing of <?= $nc ?> <?= ($m == 'm') ? 'mono' : 'stereo' ?> channels.
+	This plugin performs mixing of <?= $nc ?> <?= ($m == 's') ? 'stereo' : 'mono' ?> channels<?= ($m == 'u') ? ' into the 5.1 or 7.1 surround bus' : '' ?>.
 </p>
 <p>
 	It allows to mix the channels and apply the result mix to the additional master input.
 	All the mixed result signal is passed to the and master output. 
 </p>
 
+<?php if ($m != 'u') { ?>
 <p><b>Main controls:</b></p>
 <ul>
 	<li>
@@ -29,6 +33,10 @@
     <?php } ?>
     <li><b>In</b> - the level of the master input signal.</li>
     <li><b>Out</b> - the level of the master output signal.</li>
+    <?php if ($nc >= 32) { ?>
+    <li><b>Threads</b> - the number of threads used to process the mixer channels, one thread means single-threaded processing.</li>
+    <li><b>MT block</b> - the minimum size of the audio block in samples which is processed by multiple threads, smaller blocks are always processed by one thread.</li>
+    <?php } ?>
 </ul>
 <p><b>Mixer channel controls:</b></p>
 <ul>
@@ -37,6 +45,11 @@
 	<li><b>S</b> - solo the channel.</li>
 	<li><b>M</b> - mute the channel.</li>
 	<li><b>P</b> - invert the phase for the channel.</li>
+	<li><b>Group</b> - the bus the channel is routed to: the master bus or one of the subgroups.</li>
+	<li><b>VCA</b> - the VCA group which controls the gain of the channel.</li>
+	<li><b>Aux 1-4</b> - the send levels of the channel to the aux buses.</li>
+	<li><b>Delay</b> - the alignment delay of the channel in milliseconds, applied to both the input and the return of the channel.</li>
+	<li><b>Ret latency</b> - the latency of the return path in samples. The plugin reports the maximum latency of return paths to the host and delays the mix by it, the return of each channel is delayed by the rest to stay aligned with the input.</li>
 	<?php if ($m == 's') { ?>
 	<li><b>Pan</b> - the panning knobs for both left and right channels of the stereo channel.</li>
 	<li><b>Balance</b> - the balance between left and right channels of the stereo channel.</li>
@@ -44,3 +57,95 @@
 	<li><b>Fader</b> - the overall output gain adjustment for the channel.</li>
 	<li><b>Meter</b> - the overall output gain meter for the channel.</li>
 </ul>
+<p><b>Subgroup controls:</b></p>
+<ul>
+	<li><b>M</b> - mute the subgroup.</li>
+	<li><b>Gain</b> - the gain of the subgroup applied before it is mixed into the master bus.</li>
+	<li><b>Meter</b> - the output level meter of the subgroup.</li>
+</ul>
+<p><b>Aux bus controls:</b></p>
+<ul>
+	<li><b>Pre</b> - take the signal of channels before the channel fader and panning (pre-fader) instead of the signal after them (post-fader).
+	Mute and phase switches of the channel are applied in both cases.</li>
+	<li><b>Gain</b> - the output gain of the aux bus.</li>
+	<li><b>Meter</b> - the output level meter of the aux bus.</li>
+</ul>
+<p>Each aux bus has its own audio output<?= ($m == 's') ? ' pair' : '' ?>.</p>
+<p><b>VCA group controls:</b></p>
+<ul>
+	<li><b>Gain</b> - the gain applied to the faders of all channels assigned to the VCA group.</li>
+</ul>
+<p><b>Scenes:</b></p>
+<p>The scene holds the mix settings of all channels and of the master section: faders, panning, balance, solo, mute and phase switches,
+subgroup and VCA assignments, aux sends, subgroup, aux bus and VCA gains, dry and wet amounts, output gain, balance and mono switch.
+Channel labels are stored with the scene, alignment delays are not a part of the scene. Scenes are saved with the state of the plugin.</p>
+<ul>
+	<li><b>Scene</b> - the scene slot to store or recall.</li>
+	<li><b>Store</b> - store the current mix settings to the selected scene slot.</li>
+	<li><b>Recall</b> - recall the mix settings from the selected scene slot, nothing happens if the slot is empty.</li>
+	<li><b>Xfade</b> - the time of the crossfade from the current mix to the recalled scene, switches and subgroup assignments change immediately.
+	Controls keep their positions after the recall and take over the setting again when they are touched, the touched setting leaves the crossfade.</li>
+</ul>
+<p><b>DSP load profiling:</b></p>
+<p>The plugin provides host-visible meters of the DSP load, they are not shown in the plugin's UI.
+The load is measured as the percentage of the duration of processed audio and averaged over half a second,
+so 100% means that processing takes as long as playing the audio back.
+Profiling is available for x86 and AArch64 builds only.</p>
+<ul>
+	<li><b>Profiling</b> - enables the DSP load measurement.</li>
+	<li><b>Strip mixing</b> - the load of mixing channels into the master, subgroup and aux buses. With multi-threaded processing, this includes the metering of muted channels.</li>
+	<li><b>Silent strip metering</b> - the load of metering muted and soloed-out channels.</li>
+	<li><b>Subgroups</b> - the load of the subgroup faders.</li>
+	<li><b>Dry/wet mixing</b> - the load of mixing the dry and wet signals and applying the output balance.</li>
+	<li><b>Bypass and output metering</b> - the load of the bypass crossfade and the input and output level meters.</li>
+	<li><b>Aux buses</b> - the load of the aux bus outputs.</li>
+	<li><b>Loudness meters</b> - the load of the RMS, loudness and true peak meters. With multi-threaded processing, the metering of channels is included into the strip mixing load.</li>
+	<li><b>Total</b> - the load of the whole processing cycle.</li>
+	<li><b>Channel DSP load</b> - the load of each mixer channel.</li>
+</ul>
+<p><b>Loudness metering:</b></p>
+<p>The plugin provides host-visible RMS, loudness and peak meters for each channel, subgroup, aux bus and the output, they are not shown in the plugin's UI.
+Loudness is measured according to ITU-R BS.1770 and is reported as a gain value relative to 0 LUFS, so -23 dB of the meter correspond to -23 LUFS.
+Loudness of stereo signals sums both channels, RMS and true peak meters show the level of the loudest channel.
+Channels are metered before the fader, including return signals, so muted channels are metered too. Subgroups, aux buses and the output are metered after the fader.</p>
+<ul>
+	<li><b>Loudness</b> - enables the loudness metering, the measurements start from scratch when it gets enabled.</li>
+	<li><b>RMS level</b> - the RMS level over the last 300 milliseconds.</li>
+	<li><b>Momentary loudness</b> - the loudness over the last 400 milliseconds.</li>
+	<li><b>Short-term loudness</b> - the loudness over the last 3 seconds.</li>
+	<li><b>True peak level</b> - the peak level of the 4x oversampled signal over the last 400 milliseconds, measured for subgroups, aux buses and the output.
+	Signals that stay below -12 dBFS can not clip, for them the meter shows the sample peak.</li>
+	<li><b>Sample peak level</b> - the peak level of the channel over the last 400 milliseconds.</li>
+</ul>
+<?php } else { ?>
+<p>
+	The surround bus has eight channels in the order of 7.1 audio files: left, right, center, LFE, left surround, right surround,
+	left back and right back. The 5.1 layout uses the first six channels, the back channels receive only the dry signal.
+</p>
+<p><b>Main controls:</b></p>
+<ul>
+	<li>
+		<b>Bypass</b> - bypass switch, when turned on (led indicator is shining), the output signal is similar to input signal. That does not mean
+		that the plugin is not working.
+	</li>
+	<li><b>Layout</b> - the loudspeaker layout of the surround bus: 5.1 (speakers at 0, &plusmn;30 and &plusmn;110 degrees)
+	or 7.1 (speakers at 0, &plusmn;30, &plusmn;90 and &plusmn;150 degrees).</li>
+	<li><b>Dry amount</b> - the amount of the unprocessed (dry) signal in the output signal.</li>
+	<li><b>Wet amount</b> - the amount of the processed (wet) signal in the output signal.</li>
+	<li><b>In</b> - the levels of the master input signals.</li>
+	<li><b>Out</b> - the levels of the master output signals.</li>
+</ul>
+<p><b>Mixer channel controls:</b></p>
+<ul>
+	<li><b>Channel label</b> - custom user-defined editable channel label.</li>
+	<li><b>S</b> - solo the channel.</li>
+	<li><b>M</b> - mute the channel.</li>
+	<li><b>P</b> - invert the phase for the channel.</li>
+	<li><b>Azimuth</b> - the direction of the channel in degrees, 0 is the front, positive values are to the right, &plusmn;180 is the back.
+	The channel is panned between the pair of adjacent speakers with vector base amplitude panning (VBAP) at constant power.</li>
+	<li><b>Divergence</b> - the amount of the channel power spread uniformly over all speakers of the layout except LFE, 100% feeds all speakers equally.</li>
+	<li><b>LFE</b> - the send level of the channel to the LFE channel.</li>
+	<li><b>Fader</b> - the overall output gain adjustment for the channel.</li>
+	<li><b>Meter</b> - the overall output gain meter for the channel.</li>
+</ul>
+<?php } ?>
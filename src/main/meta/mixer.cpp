@@ -26,7 +26,7 @@
 
 #define LSP_PLUGINS_MIXER_VERSION_MAJOR       1
 #define LSP_PLUGINS_MIXER_VERSION_MINOR       0
-#define LSP_PLUGINS_MIXER_VERSION_MICRO       25
+#define LSP_PLUGINS_MIXER_VERSION_MICRO       26
 
 #define LSP_PLUGINS_MIXER_VERSION  \
     LSP_MODULE_VERSION( \
@@ -41,6 +41,46 @@ namespace lsp
     {
         //-------------------------------------------------------------------------
         // Plugin metadata
+        static const port_item_t mixer_groups[] =
+        {
+            { "Master",         "mixer.bus.master"      },
+            { "Group 1",        "mixer.bus.group_1"     },
+            { "Group 2",        "mixer.bus.group_2"     },
+            { "Group 3",        "mixer.bus.group_3"     },
+            { "Group 4",        "mixer.bus.group_4"     },
+            { NULL, NULL }
+        };
+
+        static const port_item_t mixer_vcas[] =
+        {
+            { "None",           "mixer.vca.none"        },
+            { "VCA 1",          "mixer.vca.vca_1"       },
+            { "VCA 2",          "mixer.vca.vca_2"       },
+            { "VCA 3",          "mixer.vca.vca_3"       },
+            { "VCA 4",          "mixer.vca.vca_4"       },
+            { NULL, NULL }
+        };
+
+        static const port_item_t mixer_scenes[] =
+        {
+            { "Scene 1",        "mixer.scene.scene_1"   },
+            { "Scene 2",        "mixer.scene.scene_2"   },
+            { "Scene 3",        "mixer.scene.scene_3"   },
+            { "Scene 4",        "mixer.scene.scene_4"   },
+            { "Scene 5",        "mixer.scene.scene_5"   },
+            { "Scene 6",        "mixer.scene.scene_6"   },
+            { "Scene 7",        "mixer.scene.scene_7"   },
+            { "Scene 8",        "mixer.scene.scene_8"   },
+            { NULL, NULL }
+        };
+
+        static const port_item_t mixer_layouts[] =
+        {
+            { "5.1",            "mixer.layout.5_1"      },
+            { "7.1",            "mixer.layout.7_1"      },
+            { NULL, NULL }
+        };
+
         #define MIX_MONO_PORTS \
             PORTS_MONO_PLUGIN, \
             OPT_SEND_MONO("send", "sout", "Mix send"), \
@@ -51,6 +91,25 @@ namespace lsp
             OPT_SEND_STEREO("send", "sout", "Mix send"), \
             OPT_RETURN_STEREO("return", "rin", "Mix return")
 
+        // The surround bus follows the channel order of 7.1 WAV files, the 5.1 layout uses the first six channels
+        #define MIX_SURROUND_PORTS \
+            AUDIO_INPUT("in_l", "Input left"), \
+            AUDIO_INPUT("in_r", "Input right"), \
+            AUDIO_INPUT("in_c", "Input center"), \
+            AUDIO_INPUT("in_lfe", "Input LFE"), \
+            AUDIO_INPUT("in_ls", "Input left surround"), \
+            AUDIO_INPUT("in_rs", "Input right surround"), \
+            AUDIO_INPUT("in_lb", "Input left back"), \
+            AUDIO_INPUT("in_rb", "Input right back"), \
+            AUDIO_OUTPUT("out_l", "Output left"), \
+            AUDIO_OUTPUT("out_r", "Output right"), \
+            AUDIO_OUTPUT("out_c", "Output center"), \
+            AUDIO_OUTPUT("out_lfe", "Output LFE"), \
+            AUDIO_OUTPUT("out_ls", "Output left surround"), \
+            AUDIO_OUTPUT("out_rs", "Output right surround"), \
+            AUDIO_OUTPUT("out_lb", "Output left back"), \
+            AUDIO_OUTPUT("out_rb", "Output right back")
+
         #define MIX_MONO_CHANNEL(id, label) \
             AUDIO_INPUT("in" id, "Audio input " label), \
             OPT_RETURN_MONO("ret" id, "rin" id, "Audio channel " label " return"), \
@@ -74,6 +133,17 @@ namespace lsp
             METER_GAIN("cl" id "l", "Channel signal level left " label, GAIN_AMP_P_48_DB), \
             METER_GAIN("cl" id "r", "Channel signal level right " label, GAIN_AMP_P_48_DB)
 
+        #define MIX_SURROUND_CHANNEL(id, label) \
+            AUDIO_INPUT("in" id, "Audio input " label), \
+            SWITCH("cs" id, "Channel solo " label, "Solo " label, 0.0f), \
+            SWITCH("cm" id, "Channel mute " label, "Mute " label, 0.0f), \
+            SWITCH("ci" id, "Channel phase invert " label, "Phase " label, 0.0f), \
+            CONTROL("caz" id, "Channel azimuth " label, "Azimuth " label, U_DEG, meta::mixer::AZIMUTH), \
+            CONTROL("cdv" id, "Channel divergence " label, "Divergence " label, U_PERCENT, meta::mixer::DIVERGENCE), \
+            LOG_CONTROL("cfe" id, "Channel LFE send " label, "LFE " label, U_GAIN_AMP, meta::mixer::SEND_GAIN), \
+            LOG_CONTROL("cg" id, "Channel gain " label, "Gain " label, U_GAIN_AMP, meta::mixer::CHANNEL_GAIN), \
+            METER_GAIN("cl" id, "Channel signal level " label, GAIN_AMP_P_48_DB)
+
         #define MIX_MONO_GLOBAL \
             DRY_GAIN(1.0f), \
             WET_GAIN(1.0f), \
@@ -92,125 +162,230 @@ namespace lsp
             METER_GAIN("olm_l", "Output level meter left", GAIN_AMP_P_48_DB), \
             METER_GAIN("olm_r", "Output level meter right", GAIN_AMP_P_48_DB)
 
-        static const port_t mixer_x4_mono_ports[] =
-        {
-            MIX_MONO_PORTS,
-            BYPASS,
-            MIX_MONO_GLOBAL,
-
-            MIX_MONO_CHANNEL("_1", "1"),
-            MIX_MONO_CHANNEL("_2", "2"),
-            MIX_MONO_CHANNEL("_3", "3"),
-            MIX_MONO_CHANNEL("_4", "4"),
-
-            PORTS_END
-        };
-
-        static const port_t mixer_x8_mono_ports[] =
-        {
-            MIX_MONO_PORTS,
-            BYPASS,
-            MIX_MONO_GLOBAL,
-
-            MIX_MONO_CHANNEL("_1", "1"),
-            MIX_MONO_CHANNEL("_2", "2"),
-            MIX_MONO_CHANNEL("_3", "3"),
-            MIX_MONO_CHANNEL("_4", "4"),
-            MIX_MONO_CHANNEL("_5", "5"),
-            MIX_MONO_CHANNEL("_6", "6"),
-            MIX_MONO_CHANNEL("_7", "7"),
-            MIX_MONO_CHANNEL("_8", "8"),
-
-            PORTS_END
-        };
-
-        static const port_t mixer_x16_mono_ports[] =
-        {
-            MIX_MONO_PORTS,
-            BYPASS,
-            MIX_MONO_GLOBAL,
-
-            MIX_MONO_CHANNEL("_1", "1"),
-            MIX_MONO_CHANNEL("_2", "2"),
-            MIX_MONO_CHANNEL("_3", "3"),
-            MIX_MONO_CHANNEL("_4", "4"),
-            MIX_MONO_CHANNEL("_5", "5"),
-            MIX_MONO_CHANNEL("_6", "6"),
-            MIX_MONO_CHANNEL("_7", "7"),
-            MIX_MONO_CHANNEL("_8", "8"),
-            MIX_MONO_CHANNEL("_9", "9"),
-            MIX_MONO_CHANNEL("_10", "10"),
-            MIX_MONO_CHANNEL("_11", "11"),
-            MIX_MONO_CHANNEL("_12", "12"),
-            MIX_MONO_CHANNEL("_13", "13"),
-            MIX_MONO_CHANNEL("_14", "14"),
-            MIX_MONO_CHANNEL("_15", "15"),
-            MIX_MONO_CHANNEL("_16", "16"),
-
-            PORTS_END
-        };
-
-        static const port_t mixer_x4_stereo_ports[] =
-        {
-            MIX_STEREO_PORTS,
-            BYPASS,
-            MIX_STEREO_GLOBAL,
-
-            MIX_STEREO_CHANNEL("_1", "1"),
-            MIX_STEREO_CHANNEL("_2", "2"),
-            MIX_STEREO_CHANNEL("_3", "3"),
-            MIX_STEREO_CHANNEL("_4", "4"),
-
-            PORTS_END
-        };
-
-        static const port_t mixer_x8_stereo_ports[] =
-        {
-            MIX_STEREO_PORTS,
-            BYPASS,
-            MIX_STEREO_GLOBAL,
-
-            MIX_STEREO_CHANNEL("_1", "1"),
-            MIX_STEREO_CHANNEL("_2", "2"),
-            MIX_STEREO_CHANNEL("_3", "3"),
-            MIX_STEREO_CHANNEL("_4", "4"),
-            MIX_STEREO_CHANNEL("_5", "5"),
-            MIX_STEREO_CHANNEL("_6", "6"),
-            MIX_STEREO_CHANNEL("_7", "7"),
-            MIX_STEREO_CHANNEL("_8", "8"),
-
-            PORTS_END
-        };
-
-        static const port_t mixer_x16_stereo_ports[] =
-        {
-            MIX_STEREO_PORTS,
-            BYPASS,
-            MIX_STEREO_GLOBAL,
-
-            MIX_STEREO_CHANNEL("_1", "1"),
-            MIX_STEREO_CHANNEL("_2", "2"),
-            MIX_STEREO_CHANNEL("_3", "3"),
-            MIX_STEREO_CHANNEL("_4", "4"),
-            MIX_STEREO_CHANNEL("_5", "5"),
-            MIX_STEREO_CHANNEL("_6", "6"),
-            MIX_STEREO_CHANNEL("_7", "7"),
-            MIX_STEREO_CHANNEL("_8", "8"),
-            MIX_STEREO_CHANNEL("_9", "9"),
-            MIX_STEREO_CHANNEL("_10", "10"),
-            MIX_STEREO_CHANNEL("_11", "11"),
-            MIX_STEREO_CHANNEL("_12", "12"),
-            MIX_STEREO_CHANNEL("_13", "13"),
-            MIX_STEREO_CHANNEL("_14", "14"),
-            MIX_STEREO_CHANNEL("_15", "15"),
-            MIX_STEREO_CHANNEL("_16", "16"),
-
-            PORTS_END
-        };
+        #define MIX_SURROUND_GLOBAL \
+            COMBO("layout", "Surround layout", "Layout", 1, mixer_layouts), \
+            DRY_GAIN(1.0f), \
+            WET_GAIN(1.0f), \
+            LOG_CONTROL("g_out", "Output gain", "Out gain", U_GAIN_AMP, meta::mixer::CHANNEL_GAIN), \
+            METER_GAIN("ilm_l", "Input level meter left", GAIN_AMP_P_48_DB), \
+            METER_GAIN("ilm_r", "Input level meter right", GAIN_AMP_P_48_DB), \
+            METER_GAIN("ilm_c", "Input level meter center", GAIN_AMP_P_48_DB), \
+            METER_GAIN("ilm_lfe", "Input level meter LFE", GAIN_AMP_P_48_DB), \
+            METER_GAIN("ilm_ls", "Input level meter left surround", GAIN_AMP_P_48_DB), \
+            METER_GAIN("ilm_rs", "Input level meter right surround", GAIN_AMP_P_48_DB), \
+            METER_GAIN("ilm_lb", "Input level meter left back", GAIN_AMP_P_48_DB), \
+            METER_GAIN("ilm_rb", "Input level meter right back", GAIN_AMP_P_48_DB), \
+            METER_GAIN("olm_l", "Output level meter left", GAIN_AMP_P_48_DB), \
+            METER_GAIN("olm_r", "Output level meter right", GAIN_AMP_P_48_DB), \
+            METER_GAIN("olm_c", "Output level meter center", GAIN_AMP_P_48_DB), \
+            METER_GAIN("olm_lfe", "Output level meter LFE", GAIN_AMP_P_48_DB), \
+            METER_GAIN("olm_ls", "Output level meter left surround", GAIN_AMP_P_48_DB), \
+            METER_GAIN("olm_rs", "Output level meter right surround", GAIN_AMP_P_48_DB), \
+            METER_GAIN("olm_lb", "Output level meter left back", GAIN_AMP_P_48_DB), \
+            METER_GAIN("olm_rb", "Output level meter right back", GAIN_AMP_P_48_DB)
+
+        // Parallel processing controls, provided by large mixers only
+        #define MIX_SERIAL
+        #define MIX_PARALLEL \
+            INT_CONTROL("threads", "Number of processing threads", "Threads", U_NONE, meta::mixer::THREADS), \
+            INT_CONTROL("mt_min", "Parallel processing block size threshold", "MT block", U_SAMPLES, meta::mixer::MT_BLOCK),
+
+        // Channel sequence generator: MIX_SEQ_N(M) expands to M(1) M(2) ... M(N),
+        // MIX_DIGITS_N(M, t) expands to M(t0) M(t1) ... M(tN) for the tens digit t
+        #define MIX_DIGITS_0(M, t)      M(t ## 0)
+        #define MIX_DIGITS_1(M, t)      MIX_DIGITS_0(M, t) M(t ## 1)
+        #define MIX_DIGITS_2(M, t)      MIX_DIGITS_1(M, t) M(t ## 2)
+        #define MIX_DIGITS_3(M, t)      MIX_DIGITS_2(M, t) M(t ## 3)
+        #define MIX_DIGITS_4(M, t)      MIX_DIGITS_3(M, t) M(t ## 4)
+        #define MIX_DIGITS_5(M, t)      MIX_DIGITS_4(M, t) M(t ## 5)
+        #define MIX_DIGITS_6(M, t)      MIX_DIGITS_5(M, t) M(t ## 6)
+        #define MIX_DIGITS_7(M, t)      MIX_DIGITS_6(M, t) M(t ## 7)
+        #define MIX_DIGITS_8(M, t)      MIX_DIGITS_7(M, t) M(t ## 8)
+        #define MIX_DIGITS_9(M, t)      MIX_DIGITS_8(M, t) M(t ## 9)
+
+        #define MIX_SEQ_4(M)            M(1) M(2) M(3) M(4)
+        #define MIX_SEQ_8(M)            MIX_SEQ_4(M) M(5) M(6) M(7) M(8)
+        #define MIX_SEQ_9(M)            MIX_SEQ_8(M) M(9)
+        #define MIX_SEQ_16(M)           MIX_SEQ_9(M) MIX_DIGITS_6(M, 1)
+        #define MIX_SEQ_32(M)           MIX_SEQ_9(M) MIX_DIGITS_9(M, 1) MIX_DIGITS_9(M, 2) MIX_DIGITS_2(M, 3)
+        #define MIX_SEQ_64(M)           MIX_SEQ_9(M) MIX_DIGITS_9(M, 1) MIX_DIGITS_9(M, 2) MIX_DIGITS_9(M, 3) \
+                                        MIX_DIGITS_9(M, 4) MIX_DIGITS_9(M, 5) MIX_DIGITS_4(M, 6)
+
+        #define MIX_MONO_CHANNEL_N(i)   MIX_MONO_CHANNEL("_" #i, #i),
+        #define MIX_STEREO_CHANNEL_N(i) MIX_STEREO_CHANNEL("_" #i, #i),
+        #define MIX_SURROUND_CHANNEL_N(i)   MIX_SURROUND_CHANNEL("_" #i, #i),
+
+        // Routing of channels to subgroups and VCA groups, subgroups and VCA groups
+        #define MIX_ROUTE_N(i) \
+            COMBO("cgr_" #i, "Channel subgroup " #i, "Group " #i, 0, mixer_groups), \
+            COMBO("cvc_" #i, "Channel VCA group " #i, "VCA " #i, 0, mixer_vcas),
+
+        #define MIX_MONO_SUBGROUP_N(i) \
+            SWITCH("sgm_" #i, "Subgroup mute " #i, "Group mute " #i, 0.0f), \
+            LOG_CONTROL("sgg_" #i, "Subgroup gain " #i, "Group gain " #i, U_GAIN_AMP, meta::mixer::CHANNEL_GAIN), \
+            METER_GAIN("sgl_" #i, "Subgroup signal level " #i, GAIN_AMP_P_48_DB),
+
+        #define MIX_STEREO_SUBGROUP_N(i) \
+            SWITCH("sgm_" #i, "Subgroup mute " #i, "Group mute " #i, 0.0f), \
+            LOG_CONTROL("sgg_" #i, "Subgroup gain " #i, "Group gain " #i, U_GAIN_AMP, meta::mixer::CHANNEL_GAIN), \
+            METER_GAIN("sgl_" #i "l", "Subgroup signal level left " #i, GAIN_AMP_P_48_DB), \
+            METER_GAIN("sgl_" #i "r", "Subgroup signal level right " #i, GAIN_AMP_P_48_DB),
+
+        #define MIX_VCA_N(i) \
+            LOG_CONTROL("vca_" #i, "VCA group gain " #i, "VCA gain " #i, U_GAIN_AMP, meta::mixer::CHANNEL_GAIN),
+
+        // Aux sends of channels and aux buses
+        #define MIX_SENDS_N(i) \
+            LOG_CONTROL("cx1_" #i, "Channel aux send 1 " #i, "Aux 1 " #i, U_GAIN_AMP, meta::mixer::SEND_GAIN), \
+            LOG_CONTROL("cx2_" #i, "Channel aux send 2 " #i, "Aux 2 " #i, U_GAIN_AMP, meta::mixer::SEND_GAIN), \
+            LOG_CONTROL("cx3_" #i, "Channel aux send 3 " #i, "Aux 3 " #i, U_GAIN_AMP, meta::mixer::SEND_GAIN), \
+            LOG_CONTROL("cx4_" #i, "Channel aux send 4 " #i, "Aux 4 " #i, U_GAIN_AMP, meta::mixer::SEND_GAIN),
+
+        #define MIX_MONO_AUX_N(i) \
+            AUDIO_OUTPUT("aux_" #i, "Aux output " #i), \
+            SWITCH("axp_" #i, "Aux pre-fader tap " #i, "Aux pre " #i, 0.0f), \
+            LOG_CONTROL("axg_" #i, "Aux gain " #i, "Aux gain " #i, U_GAIN_AMP, meta::mixer::CHANNEL_GAIN), \
+            METER_GAIN("axl_" #i, "Aux signal level " #i, GAIN_AMP_P_48_DB),
+
+        #define MIX_STEREO_AUX_N(i) \
+            AUDIO_OUTPUT("aux_" #i "l", "Aux output left " #i), \
+            AUDIO_OUTPUT("aux_" #i "r", "Aux output right " #i), \
+            SWITCH("axp_" #i, "Aux pre-fader tap " #i, "Aux pre " #i, 0.0f), \
+            LOG_CONTROL("axg_" #i, "Aux gain " #i, "Aux gain " #i, U_GAIN_AMP, meta::mixer::CHANNEL_GAIN), \
+            METER_GAIN("axl_" #i "l", "Aux signal level left " #i, GAIN_AMP_P_48_DB), \
+            METER_GAIN("axl_" #i "r", "Aux signal level right " #i, GAIN_AMP_P_48_DB),
+
+        // DSP load profiling of processing stages and strips
+        #define MIX_PROFILE \
+            SWITCH("prof", "DSP load profiling", "Profiling", 0.0f), \
+            METER("pf_mix", "DSP load of strip mixing", U_PERCENT, meta::mixer::DSP_LOAD), \
+            METER("pf_met", "DSP load of silent strip metering", U_PERCENT, meta::mixer::DSP_LOAD), \
+            METER("pf_grp", "DSP load of subgroups", U_PERCENT, meta::mixer::DSP_LOAD), \
+            METER("pf_mst", "DSP load of dry/wet mixing", U_PERCENT, meta::mixer::DSP_LOAD), \
+            METER("pf_byp", "DSP load of bypass and output metering", U_PERCENT, meta::mixer::DSP_LOAD), \
+            METER("pf_aux", "DSP load of aux buses", U_PERCENT, meta::mixer::DSP_LOAD), \
+            METER("pf_lmt", "DSP load of loudness meters", U_PERCENT, meta::mixer::DSP_LOAD), \
+            METER("pf_tot", "Total DSP load", U_PERCENT, meta::mixer::DSP_LOAD),
+
+        #define MIX_PROFILE_N(i) \
+            METER("pfc_" #i, "Channel DSP load " #i, U_PERCENT, meta::mixer::DSP_LOAD),
+
+        // RMS, loudness and true peak meters of the master bus, subgroups, aux buses and strips
+        #define MIX_LOUDNESS \
+            SWITCH("lmtr", "Loudness meters", "Loudness", 1.0f), \
+            METER_GAIN("orm", "Output RMS level", GAIN_AMP_P_48_DB), \
+            METER_GAIN("oml", "Output momentary loudness", GAIN_AMP_P_48_DB), \
+            METER_GAIN("osl", "Output short-term loudness", GAIN_AMP_P_48_DB), \
+            METER_GAIN("otp", "Output true peak level", GAIN_AMP_P_48_DB),
+
+        #define MIX_LOUDNESS_SUBGROUP_N(i) \
+            METER_GAIN("sgrm_" #i, "Subgroup RMS level " #i, GAIN_AMP_P_48_DB), \
+            METER_GAIN("sgml_" #i, "Subgroup momentary loudness " #i, GAIN_AMP_P_48_DB), \
+            METER_GAIN("sgsl_" #i, "Subgroup short-term loudness " #i, GAIN_AMP_P_48_DB), \
+            METER_GAIN("sgtp_" #i, "Subgroup true peak level " #i, GAIN_AMP_P_48_DB),
+
+        #define MIX_LOUDNESS_AUX_N(i) \
+            METER_GAIN("axrm_" #i, "Aux RMS level " #i, GAIN_AMP_P_48_DB), \
+            METER_GAIN("axml_" #i, "Aux momentary loudness " #i, GAIN_AMP_P_48_DB), \
+            METER_GAIN("axsl_" #i, "Aux short-term loudness " #i, GAIN_AMP_P_48_DB), \
+            METER_GAIN("axtp_" #i, "Aux true peak level " #i, GAIN_AMP_P_48_DB),
+
+        #define MIX_LOUDNESS_N(i) \
+            METER_GAIN("crm_" #i, "Channel RMS level " #i, GAIN_AMP_P_48_DB), \
+            METER_GAIN("cml_" #i, "Channel momentary loudness " #i, GAIN_AMP_P_48_DB), \
+            METER_GAIN("csl_" #i, "Channel short-term loudness " #i, GAIN_AMP_P_48_DB), \
+            METER_GAIN("ctp_" #i, "Channel sample peak level " #i, GAIN_AMP_P_48_DB),
+
+        // Alignment delays of strips and latencies of strip return paths
+        #define MIX_DELAY_N(i) \
+            CONTROL("cdl_" #i, "Channel delay " #i, "Delay " #i, U_MSEC, meta::mixer::CHANNEL_DELAY), \
+            INT_CONTROL("crl_" #i, "Channel return latency " #i, "Ret latency " #i, U_SAMPLES, meta::mixer::RETURN_LATENCY),
+
+        // Scene slots: store and recall of mix settings
+        #define MIX_SCENES \
+            COMBO("scn", "Scene slot", "Scene", 0, mixer_scenes), \
+            TRIGGER("scns", "Store scene", "Store"), \
+            TRIGGER("scnr", "Recall scene", "Recall"), \
+            CONTROL("scnf", "Scene crossfade time", "Xfade", U_MSEC, meta::mixer::SCENE_FADE),
+
+        #define MIX_MONO_PORT_LIST(n, parallel) \
+            static const port_t mixer_x ## n ## _mono_ports[] = \
+            { \
+                MIX_MONO_PORTS, \
+                BYPASS, \
+                MIX_MONO_GLOBAL, \
+                parallel \
+                MIX_SEQ_ ## n(MIX_MONO_CHANNEL_N) \
+                MIX_SEQ_ ## n(MIX_ROUTE_N) \
+                MIX_SEQ_4(MIX_MONO_SUBGROUP_N) \
+                MIX_SEQ_4(MIX_VCA_N) \
+                MIX_SEQ_ ## n(MIX_SENDS_N) \
+                MIX_SEQ_4(MIX_MONO_AUX_N) \
+                MIX_PROFILE \
+                MIX_SEQ_ ## n(MIX_PROFILE_N) \
+                MIX_LOUDNESS \
+                MIX_SEQ_4(MIX_LOUDNESS_SUBGROUP_N) \
+                MIX_SEQ_4(MIX_LOUDNESS_AUX_N) \
+                MIX_SEQ_ ## n(MIX_LOUDNESS_N) \
+                MIX_SEQ_ ## n(MIX_DELAY_N) \
+                MIX_SCENES \
+                PORTS_END \
+            }
+
+        #define MIX_STEREO_PORT_LIST(n, parallel) \
+            static const port_t mixer_x ## n ## _stereo_ports[] = \
+            { \
+                MIX_STEREO_PORTS, \
+                BYPASS, \
+                MIX_STEREO_GLOBAL, \
+                parallel \
+                MIX_SEQ_ ## n(MIX_STEREO_CHANNEL_N) \
+                MIX_SEQ_ ## n(MIX_ROUTE_N) \
+                MIX_SEQ_4(MIX_STEREO_SUBGROUP_N) \
+                MIX_SEQ_4(MIX_VCA_N) \
+                MIX_SEQ_ ## n(MIX_SENDS_N) \
+                MIX_SEQ_4(MIX_STEREO_AUX_N) \
+                MIX_PROFILE \
+                MIX_SEQ_ ## n(MIX_PROFILE_N) \
+                MIX_LOUDNESS \
+                MIX_SEQ_4(MIX_LOUDNESS_SUBGROUP_N) \
+                MIX_SEQ_4(MIX_LOUDNESS_AUX_N) \
+                MIX_SEQ_ ## n(MIX_LOUDNESS_N) \
+                MIX_SEQ_ ## n(MIX_DELAY_N) \
+                MIX_SCENES \
+                PORTS_END \
+            }
+
+        #define MIX_SURROUND_PORT_LIST(n) \
+            static const port_t mixer_x ## n ## _surround_ports[] = \
+            { \
+                MIX_SURROUND_PORTS, \
+                BYPASS, \
+                MIX_SURROUND_GLOBAL, \
+                MIX_SEQ_ ## n(MIX_SURROUND_CHANNEL_N) \
+                PORTS_END \
+            }
+
+        MIX_MONO_PORT_LIST(4, MIX_SERIAL);
+        MIX_MONO_PORT_LIST(8, MIX_SERIAL);
+        MIX_MONO_PORT_LIST(16, MIX_SERIAL);
+        MIX_MONO_PORT_LIST(32, MIX_PARALLEL);
+        MIX_MONO_PORT_LIST(64, MIX_PARALLEL);
+
+        MIX_STEREO_PORT_LIST(4, MIX_SERIAL);
+        MIX_STEREO_PORT_LIST(8, MIX_SERIAL);
+        MIX_STEREO_PORT_LIST(16, MIX_SERIAL);
+        MIX_STEREO_PORT_LIST(32, MIX_PARALLEL);
+        MIX_STEREO_PORT_LIST(64, MIX_PARALLEL);
+
+        MIX_SURROUND_PORT_LIST(8);
+        MIX_SURROUND_PORT_LIST(16);
+        MIX_SURROUND_PORT_LIST(32);
 
         static const int plugin_classes[]       = { C_MIXER, -1 };
         static const int clap_features_mono[]   = { CF_AUDIO_EFFECT, CF_MIXING, CF_MONO, -1 };
         static const int clap_features_stereo[] = { CF_AUDIO_EFFECT, CF_MIXING, CF_STEREO, -1 };
+        static const int clap_features_surround[] = { CF_AUDIO_EFFECT, CF_MIXING, CF_SURROUND, -1 };
 
         const meta::bundle_t mixer_bundle =
         {
@@ -223,122 +398,86 @@ namespace lsp
 
         #define MIXER_GROUP_PORTS(i) \
             MONO_PORT_GROUP_PORT(mixer_pg_mono_ ## i, "in_" #i); \
-            STEREO_PORT_GROUP_PORTS(mixer_pg_stereo_ ## i, "in_" #i "l", "in_" #i "r"); \
+            STEREO_PORT_GROUP_PORTS(mixer_pg_stereo_ ## i, "in_" #i "l", "in_" #i "r");
 
-        #define MIXER_MONO_GROUP(i) \
-            { "mix_in" #i, "Mixer input " #i,        GRP_MONO,       PGF_IN,    mixer_pg_mono_ ## i ##_ports        }
+        #define MIXER_AUX_GROUP_PORTS(i) \
+            MONO_PORT_GROUP_PORT(mixer_pg_aux_mono_ ## i, "aux_" #i); \
+            STEREO_PORT_GROUP_PORTS(mixer_pg_aux_stereo_ ## i, "aux_" #i "l", "aux_" #i "r");
 
-        #define MIXER_STEREO_GROUP(i) \
-            { "mix_in" #i, "Mixer input " #i,        GRP_STEREO,     PGF_IN,    mixer_pg_stereo_ ## i ##_ports      }
-
-        MIXER_GROUP_PORTS(1);
-        MIXER_GROUP_PORTS(2);
-        MIXER_GROUP_PORTS(3);
-        MIXER_GROUP_PORTS(4);
-        MIXER_GROUP_PORTS(5);
-        MIXER_GROUP_PORTS(6);
-        MIXER_GROUP_PORTS(7);
-        MIXER_GROUP_PORTS(8);
-        MIXER_GROUP_PORTS(9);
-        MIXER_GROUP_PORTS(10);
-        MIXER_GROUP_PORTS(11);
-        MIXER_GROUP_PORTS(12);
-        MIXER_GROUP_PORTS(13);
-        MIXER_GROUP_PORTS(14);
-        MIXER_GROUP_PORTS(15);
-        MIXER_GROUP_PORTS(16);
-
-        static const port_group_t mixer_x4_mono_port_groups[] =
-        {
-            MAIN_MONO_PORT_GROUPS,
-            MIXER_MONO_GROUP(1),
-            MIXER_MONO_GROUP(2),
-            MIXER_MONO_GROUP(3),
-            MIXER_MONO_GROUP(4),
-            PORT_GROUPS_END
-        };
+        #define MIXER_MONO_AUX_GROUP(i) \
+            { "aux_out" #i, "Aux output " #i,        GRP_MONO,       PGF_OUT,   mixer_pg_aux_mono_ ## i ##_ports    },
 
-        static const port_group_t mixer_x8_mono_port_groups[] =
-        {
-            MAIN_MONO_PORT_GROUPS,
-            MIXER_MONO_GROUP(1),
-            MIXER_MONO_GROUP(2),
-            MIXER_MONO_GROUP(3),
-            MIXER_MONO_GROUP(4),
-            MIXER_MONO_GROUP(5),
-            MIXER_MONO_GROUP(6),
-            MIXER_MONO_GROUP(7),
-            MIXER_MONO_GROUP(8),
-            PORT_GROUPS_END
-        };
+        #define MIXER_STEREO_AUX_GROUP(i) \
+            { "aux_out" #i, "Aux output " #i,        GRP_STEREO,     PGF_OUT,   mixer_pg_aux_stereo_ ## i ##_ports  },
 
-        static const port_group_t mixer_x16_mono_port_groups[] =
-        {
-            MAIN_MONO_PORT_GROUPS,
-            MIXER_MONO_GROUP(1),
-            MIXER_MONO_GROUP(2),
-            MIXER_MONO_GROUP(3),
-            MIXER_MONO_GROUP(4),
-            MIXER_MONO_GROUP(5),
-            MIXER_MONO_GROUP(6),
-            MIXER_MONO_GROUP(7),
-            MIXER_MONO_GROUP(8),
-            MIXER_MONO_GROUP(9),
-            MIXER_MONO_GROUP(10),
-            MIXER_MONO_GROUP(11),
-            MIXER_MONO_GROUP(12),
-            MIXER_MONO_GROUP(13),
-            MIXER_MONO_GROUP(14),
-            MIXER_MONO_GROUP(15),
-            MIXER_MONO_GROUP(16),
-            PORT_GROUPS_END
-        };
-
-        static const port_group_t mixer_x4_stereo_port_groups[] =
-        {
-            MAIN_STEREO_PORT_GROUPS,
-            MIXER_STEREO_GROUP(1),
-            MIXER_STEREO_GROUP(2),
-            MIXER_STEREO_GROUP(3),
-            MIXER_STEREO_GROUP(4),
-            PORT_GROUPS_END
-        };
-
-        static const port_group_t mixer_x8_stereo_port_groups[] =
-        {
-            MAIN_STEREO_PORT_GROUPS,
-            MIXER_STEREO_GROUP(1),
-            MIXER_STEREO_GROUP(2),
-            MIXER_STEREO_GROUP(3),
-            MIXER_STEREO_GROUP(4),
-            MIXER_STEREO_GROUP(5),
-            MIXER_STEREO_GROUP(6),
-            MIXER_STEREO_GROUP(7),
-            MIXER_STEREO_GROUP(8),
-            PORT_GROUPS_END
-        };
+        #define MIXER_MONO_GROUP(i) \
+            { "mix_in" #i, "Mixer input " #i,        GRP_MONO,       PGF_IN,    mixer_pg_mono_ ## i ##_ports        },
 
-        static const port_group_t mixer_x16_stereo_port_groups[] =
-        {
-            MAIN_STEREO_PORT_GROUPS,
-            MIXER_STEREO_GROUP(1),
-            MIXER_STEREO_GROUP(2),
-            MIXER_STEREO_GROUP(3),
-            MIXER_STEREO_GROUP(4),
-            MIXER_STEREO_GROUP(5),
-            MIXER_STEREO_GROUP(6),
-            MIXER_STEREO_GROUP(7),
-            MIXER_STEREO_GROUP(8),
-            MIXER_STEREO_GROUP(9),
-            MIXER_STEREO_GROUP(10),
-            MIXER_STEREO_GROUP(11),
-            MIXER_STEREO_GROUP(12),
-            MIXER_STEREO_GROUP(13),
-            MIXER_STEREO_GROUP(14),
-            MIXER_STEREO_GROUP(15),
-            MIXER_STEREO_GROUP(16),
-            PORT_GROUPS_END
-        };
+        #define MIXER_STEREO_GROUP(i) \
+            { "mix_in" #i, "Mixer input " #i,        GRP_STEREO,     PGF_IN,    mixer_pg_stereo_ ## i ##_ports      },
+
+        #define MIX_MONO_PORT_GROUPS(n) \
+            static const port_group_t mixer_x ## n ## _mono_port_groups[] = \
+            { \
+                MAIN_MONO_PORT_GROUPS, \
+                MIX_SEQ_ ## n(MIXER_MONO_GROUP) \
+                MIX_SEQ_4(MIXER_MONO_AUX_GROUP) \
+                PORT_GROUPS_END \
+            }
+
+        #define MIX_STEREO_PORT_GROUPS(n) \
+            static const port_group_t mixer_x ## n ## _stereo_port_groups[] = \
+            { \
+                MAIN_STEREO_PORT_GROUPS, \
+                MIX_SEQ_ ## n(MIXER_STEREO_GROUP) \
+                MIX_SEQ_4(MIXER_STEREO_AUX_GROUP) \
+                PORT_GROUPS_END \
+            }
+
+        #define MIX_SURROUND_PORT_GROUP_PORTS(name, pfx) \
+            static const port_group_item_t name ## _ports[] = \
+            { \
+                { pfx "_l",     PGR_LEFT            }, \
+                { pfx "_r",     PGR_RIGHT           }, \
+                { pfx "_c",     PGR_CENTER          }, \
+                { pfx "_lfe",   PGR_LO_FREQUENCY    }, \
+                { pfx "_ls",    PGR_SIDE_LEFT       }, \
+                { pfx "_rs",    PGR_SIDE_RIGHT      }, \
+                { pfx "_lb",    PGR_REAR_LEFT       }, \
+                { pfx "_rb",    PGR_REAR_RIGHT      }, \
+                { NULL,         PGR_CENTER          } \
+            }
+
+        #define MIX_SURROUND_PORT_GROUPS(n) \
+            static const port_group_t mixer_x ## n ## _surround_port_groups[] = \
+            { \
+                { "in", "Input",    GRP_7_1,    PGF_IN | PGF_MAIN,  mixer_pg_surround_in_ports     }, \
+                { "out", "Output",  GRP_7_1,    PGF_OUT | PGF_MAIN, mixer_pg_surround_out_ports    }, \
+                MIX_SEQ_ ## n(MIXER_MONO_GROUP) \
+                PORT_GROUPS_END \
+            }
+
+        MIX_SEQ_64(MIXER_GROUP_PORTS)
+        MIX_SEQ_4(MIXER_AUX_GROUP_PORTS)
+
+        MIX_MONO_PORT_GROUPS(4);
+        MIX_MONO_PORT_GROUPS(8);
+        MIX_MONO_PORT_GROUPS(16);
+        MIX_MONO_PORT_GROUPS(32);
+        MIX_MONO_PORT_GROUPS(64);
+
+        MIX_STEREO_PORT_GROUPS(4);
+        MIX_STEREO_PORT_GROUPS(8);
+        MIX_STEREO_PORT_GROUPS(16);
+        MIX_STEREO_PORT_GROUPS(32);
+        MIX_STEREO_PORT_GROUPS(64);
+
+        MIX_SURROUND_PORT_GROUP_PORTS(mixer_pg_surround_in, "in");
+        MIX_SURROUND_PORT_GROUP_PORTS(mixer_pg_surround_out, "out");
+
+        MIX_SURROUND_PORT_GROUPS(8);
+        MIX_SURROUND_PORT_GROUPS(16);
+        MIX_SURROUND_PORT_GROUPS(32);
 
         const plugin_t mixer_x4_mono =
         {
@@ -436,6 +575,70 @@ namespace lsp
         };
         LSP_REGISTER_METADATA(mixer_x16_mono);
 
+        const plugin_t mixer_x32_mono =
+        {
+            "Mischer x32 Mono",
+            "Mixer x32 Mono",
+            "Mixer x32 Mono",
+            "M32M",
+            &developers::v_sadovnikov,
+            "mixer_x32_mono",
+            {
+                LSP_LV2_URI("mixer_x32_mono"),
+                LSP_LV2UI_URI("mixer_x32_mono"),
+                "m32m",
+                LSP_VST3_UID("m32m    m32m"),
+                LSP_VST3UI_UID("m32m    m32m"),
+                0,
+                NULL,
+                LSP_CLAP_URI("mixer_x32_mono"),
+                LSP_GST_UID("mixer_x32_mono"),
+            },
+            LSP_PLUGINS_MIXER_VERSION,
+            plugin_classes,
+            clap_features_mono,
+            E_DUMP_STATE | E_KVT_SYNC,
+            mixer_x32_mono_ports,
+            "plugins/util/mixer/mono.xml",
+            NULL,
+            mixer_x32_mono_port_groups,
+            &mixer_bundle,
+            9
+        };
+        LSP_REGISTER_METADATA(mixer_x32_mono);
+
+        const plugin_t mixer_x64_mono =
+        {
+            "Mischer x64 Mono",
+            "Mixer x64 Mono",
+            "Mixer x64 Mono",
+            "M64M",
+            &developers::v_sadovnikov,
+            "mixer_x64_mono",
+            {
+                LSP_LV2_URI("mixer_x64_mono"),
+                LSP_LV2UI_URI("mixer_x64_mono"),
+                "m64m",
+                LSP_VST3_UID("m64m    m64m"),
+                LSP_VST3UI_UID("m64m    m64m"),
+                0,
+                NULL,
+                LSP_CLAP_URI("mixer_x64_mono"),
+                LSP_GST_UID("mixer_x64_mono"),
+            },
+            LSP_PLUGINS_MIXER_VERSION,
+            plugin_classes,
+            clap_features_mono,
+            E_DUMP_STATE | E_KVT_SYNC,
+            mixer_x64_mono_ports,
+            "plugins/util/mixer/mono.xml",
+            NULL,
+            mixer_x64_mono_port_groups,
+            &mixer_bundle,
+            10
+        };
+        LSP_REGISTER_METADATA(mixer_x64_mono);
+
         const plugin_t mixer_x4_stereo =
         {
             "Mischer x4 Stereo",
@@ -532,5 +735,165 @@ namespace lsp
         };
         LSP_REGISTER_METADATA(mixer_x16_stereo);
 
+        const plugin_t mixer_x32_stereo =
+        {
+            "Mischer x32 Stereo",
+            "Mixer x32 Stereo",
+            "Mixer x32 Stereo",
+            "M32S",
+            &developers::v_sadovnikov,
+            "mixer_x32_stereo",
+            {
+                LSP_LV2_URI("mixer_x32_stereo"),
+                LSP_LV2UI_URI("mixer_x32_stereo"),
+                "m32s",
+                LSP_VST3_UID("m32s    m32s"),
+                LSP_VST3UI_UID("m32s    m32s"),
+                0,
+                NULL,
+                LSP_CLAP_URI("mixer_x32_stereo"),
+                LSP_GST_UID("mixer_x32_stereo"),
+            },
+            LSP_PLUGINS_MIXER_VERSION,
+            plugin_classes,
+            clap_features_stereo,
+            E_DUMP_STATE | E_KVT_SYNC,
+            mixer_x32_stereo_ports,
+            "plugins/util/mixer/stereo.xml",
+            NULL,
+            mixer_x32_stereo_port_groups,
+            &mixer_bundle,
+            7
+        };
+        LSP_REGISTER_METADATA(mixer_x32_stereo);
+
+        const plugin_t mixer_x64_stereo =
+        {
+            "Mischer x64 Stereo",
+            "Mixer x64 Stereo",
+            "Mixer x64 Stereo",
+            "M64S",
+            &developers::v_sadovnikov,
+            "mixer_x64_stereo",
+            {
+                LSP_LV2_URI("mixer_x64_stereo"),
+                LSP_LV2UI_URI("mixer_x64_stereo"),
+                "m64s",
+                LSP_VST3_UID("m64s    m64s"),
+                LSP_VST3UI_UID("m64s    m64s"),
+                0,
+                NULL,
+                LSP_CLAP_URI("mixer_x64_stereo"),
+                LSP_GST_UID("mixer_x64_stereo"),
+            },
+            LSP_PLUGINS_MIXER_VERSION,
+            plugin_classes,
+            clap_features_stereo,
+            E_DUMP_STATE | E_KVT_SYNC,
+            mixer_x64_stereo_ports,
+            "plugins/util/mixer/stereo.xml",
+            NULL,
+            mixer_x64_stereo_port_groups,
+            &mixer_bundle,
+            8
+        };
+        LSP_REGISTER_METADATA(mixer_x64_stereo);
+
+        const plugin_t mixer_x8_surround =
+        {
+            "Mischer x8 Surround",
+            "Mixer x8 Surround",
+            "Mixer x8 Surround",
+            "M8U",
+            &developers::v_sadovnikov,
+            "mixer_x8_surround",
+            {
+                LSP_LV2_URI("mixer_x8_surround"),
+                LSP_LV2UI_URI("mixer_x8_surround"),
+                "m08u",
+                LSP_VST3_UID("m8u     m08u"),
+                LSP_VST3UI_UID("m8u     m08u"),
+                0,
+                NULL,
+                LSP_CLAP_URI("mixer_x8_surround"),
+                LSP_GST_UID("mixer_x8_surround"),
+            },
+            LSP_PLUGINS_MIXER_VERSION,
+            plugin_classes,
+            clap_features_surround,
+            E_DUMP_STATE | E_KVT_SYNC,
+            mixer_x8_surround_ports,
+            "plugins/util/mixer/surround.xml",
+            NULL,
+            mixer_x8_surround_port_groups,
+            &mixer_bundle,
+            11
+        };
+        LSP_REGISTER_METADATA(mixer_x8_surround);
+
+        const plugin_t mixer_x16_surround =
+        {
+            "Mischer x16 Surround",
+            "Mixer x16 Surround",
+            "Mixer x16 Surround",
+            "M16U",
+            &developers::v_sadovnikov,
+            "mixer_x16_surround",
+            {
+                LSP_LV2_URI("mixer_x16_surround"),
+                LSP_LV2UI_URI("mixer_x16_surround"),
+                "m16u",
+                LSP_VST3_UID("m16u    m16u"),
+                LSP_VST3UI_UID("m16u    m16u"),
+                0,
+                NULL,
+                LSP_CLAP_URI("mixer_x16_surround"),
+                LSP_GST_UID("mixer_x16_surround"),
+            },
+            LSP_PLUGINS_MIXER_VERSION,
+            plugin_classes,
+            clap_features_surround,
+            E_DUMP_STATE | E_KVT_SYNC,
+            mixer_x16_surround_ports,
+            "plugins/util/mixer/surround.xml",
+            NULL,
+            mixer_x16_surround_port_groups,
+            &mixer_bundle,
+            12
+        };
+        LSP_REGISTER_METADATA(mixer_x16_surround);
+
+        const plugin_t mixer_x32_surround =
+        {
+            "Mischer x32 Surround",
+            "Mixer x32 Surround",
+            "Mixer x32 Surround",
+            "M32U",
+            &developers::v_sadovnikov,
+            "mixer_x32_surround",
+            {
+                LSP_LV2_URI("mixer_x32_surround"),
+                LSP_LV2UI_URI("mixer_x32_surround"),
+                "m32u",
+                LSP_VST3_UID("m32u    m32u"),
+                LSP_VST3UI_UID("m32u    m32u"),
+                0,
+                NULL,
+                LSP_CLAP_URI("mixer_x32_surround"),
+                LSP_GST_UID("mixer_x32_surround"),
+            },
+            LSP_PLUGINS_MIXER_VERSION,
+            plugin_classes,
+            clap_features_surround,
+            E_DUMP_STATE | E_KVT_SYNC,
+            mixer_x32_surround_ports,
+            "plugins/util/mixer/surround.xml",
+            NULL,
+            mixer_x32_surround_port_groups,
+            &mixer_bundle,
+            13
+        };
+        LSP_REGISTER_METADATA(mixer_x32_surround);
+
     } /* namespace meta */
 } /* namespace lsp */
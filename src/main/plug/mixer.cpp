@@ -20,21 +20,60 @@
  */
 
 #include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/atomic.h>
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/dsp/dsp.h>
 #include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/ipc/IExecutor.h>
 #include <lsp-plug.in/plug-fw/core/AudioBuffer.h>
 #include <lsp-plug.in/plug-fw/meta/func.h>
 #include <lsp-plug.in/plug-fw/meta/ports.h>
+#include <lsp-plug.in/stdlib/math.h>
 #include <lsp-plug.in/stdlib/string.h>
 
 #include <private/plugins/mixer.h>
+#include <private/plugins/mixer_kernels.h>
+#include <private/plugins/mixer_surround.h>
 #include <lsp-plug.in/shared/debug.h>
 
+#if defined(ARCH_X86)
+    #include <x86intrin.h>
+#endif /* ARCH_X86 */
+
+/* DSP load profiling of processing stages, may be compiled out by defining it to 0 */
+#ifndef LSP_PLUGINS_MIXER_PROFILING
+    #define LSP_PLUGINS_MIXER_PROFILING     1
+#endif /* LSP_PLUGINS_MIXER_PROFILING */
+
 namespace lsp
 {
-    /* The size of temporary buffer for audio processing */
-    static constexpr size_t BUFFER_SIZE     = 0x1000U;
+    /* The limits of the processing tile size (in samples) */
+    static constexpr size_t TILE_SIZE_MIN   = 0x80U;
+    static constexpr size_t TILE_SIZE_MAX   = 0x200U;
+    /* The amount of data cache the working set of one tile should fit in */
+    static constexpr size_t TILE_CACHE_SIZE = 0x4000U;
+    /* Estimate the level of muted and soloed-out channels without mixing them */
+    static constexpr bool MUTED_STRIP_METERING  = true;
+    /* The maximum number of samples processed by one batch of parallel jobs */
+    static constexpr size_t MT_CHUNK_SIZE   = 0x400U;
+    /* The number of strips processed by one parallel job */
+    static constexpr size_t MT_JOB_STRIPS   = 4;
+    /* The number of channel groups of loudness meters processed by one parallel job */
+    static constexpr size_t MT_JOB_METER_GROUPS = 2;
+    /* DSP load profiling is available for architectures with a cheap cycle counter only */
+#if (LSP_PLUGINS_MIXER_PROFILING) && (defined(ARCH_X86) || defined(ARCH_AARCH64))
+    static constexpr bool DSP_PROFILING     = true;
+#else
+    static constexpr bool DSP_PROFILING     = false;
+#endif
+    /* The time window the DSP load is averaged over, seconds */
+    static constexpr float PROFILE_WINDOW   = 0.5f;
+    /* Gains below the threshold are replaced by exact zero, so faded-out signals do not decay into subnormals */
+    static constexpr float GAIN_SNAP_THRESHOLD  = GAIN_AMP_M_120_DB;
+    /* The duration of the bypass crossfade, seconds */
+    static constexpr float BYPASS_TIME      = 0.005f;
+    /* The maximum time to wait for the cancelled scene task on destroy, milliseconds */
+    static constexpr size_t SCENE_SYNC_WAIT = 1000;
 
     namespace plugins
     {
@@ -45,55 +84,257 @@ namespace lsp
             &meta::mixer_x4_mono,
             &meta::mixer_x8_mono,
             &meta::mixer_x16_mono,
+            &meta::mixer_x32_mono,
+            &meta::mixer_x64_mono,
             &meta::mixer_x4_stereo,
             &meta::mixer_x8_stereo,
-            &meta::mixer_x16_stereo
+            &meta::mixer_x16_stereo,
+            &meta::mixer_x32_stereo,
+            &meta::mixer_x64_stereo,
+            &meta::mixer_x8_surround,
+            &meta::mixer_x16_surround,
+            &meta::mixer_x32_surround
+        };
+
+        /**
+         * Mixer engine specialised for the number of primary channels and strips,
+         * so the compiler can unroll strip loops and drop mono/stereo branching
+         */
+        template <size_t P, size_t N>
+        class mixer_engine: public mixer
+        {
+            public:
+                explicit mixer_engine(const meta::plugin_t *meta): mixer(meta, P, N)
+                {
+                    pJobFunc        = process_job<P, N>;
+                }
+
+            public:
+                virtual void process(size_t samples) override
+                {
+                    process_tiles<P, N>(samples);
+                }
+        };
+
+        template <size_t P, size_t N>
+        static plug::Module *create_engine(const meta::plugin_t *meta)
+        {
+            return new mixer_engine<P, N>(meta);
+        }
+
+        template <size_t N>
+        static plug::Module *create_surround(const meta::plugin_t *meta)
+        {
+            return new mixer_surround(meta, N);
+        }
+
+        typedef struct plugin_settings_t
+        {
+            const meta::plugin_t   *metadata;
+            plug::Module         *(*factory)(const meta::plugin_t *meta);
+        } plugin_settings_t;
+
+        static const plugin_settings_t plugin_settings[] =
+        {
+            { &meta::mixer_x4_mono,     create_engine<1, 4>     },
+            { &meta::mixer_x8_mono,     create_engine<1, 8>     },
+            { &meta::mixer_x16_mono,    create_engine<1, 16>    },
+            { &meta::mixer_x32_mono,    create_engine<1, 32>    },
+            { &meta::mixer_x64_mono,    create_engine<1, 64>    },
+            { &meta::mixer_x4_stereo,   create_engine<2, 8>     },
+            { &meta::mixer_x8_stereo,   create_engine<2, 16>    },
+            { &meta::mixer_x16_stereo,  create_engine<2, 32>    },
+            { &meta::mixer_x32_stereo,  create_engine<2, 64>    },
+            { &meta::mixer_x64_stereo,  create_engine<2, 128>   },
+            { &meta::mixer_x8_surround, create_surround<8>      },
+            { &meta::mixer_x16_surround,create_surround<16>     },
+            { &meta::mixer_x32_surround,create_surround<32>     },
+            { NULL, NULL }
         };
 
         static plug::Module *plugin_factory(const meta::plugin_t *meta)
         {
-            return new mixer(meta);
+            for (const plugin_settings_t *s = plugin_settings; s->metadata != NULL; ++s)
+                if (s->metadata == meta)
+                    return s->factory(meta);
+            return NULL;
         }
 
-        static plug::Factory factory(plugin_factory, plugins, 6);
+        static plug::Factory factory(plugin_factory, plugins, 13);
 
         //---------------------------------------------------------------------
-        // Implementation
-        mixer::mixer(const meta::plugin_t *meta):
-            Module(meta)
+        // Hot loop utilities
+        static inline bool is_silent(float old_gain, float gain)
         {
-            // Compute the number of audio channels by the number of inputs
-            size_t p_channels   = 0;
-            size_t m_channels   = 0;
+            return (old_gain == 0.0f) && (gain == 0.0f);
+        }
 
-            for (const meta::port_t *p = meta->ports; p->id != NULL; ++p)
-            {
-                if (!meta::is_audio_in_port(p))
-                    continue;
+        static inline float snap_gain(float gain)
+        {
+            return (fabsf(gain) < GAIN_SNAP_THRESHOLD) ? 0.0f : gain;
+        }
 
-                if (strcmp(p->id, meta::PORT_NAME_INPUT_L) == 0)
-                    ++p_channels;
-                else if (strcmp(p->id, meta::PORT_NAME_INPUT_R) == 0)
-                    ++p_channels;
-                else if (strcmp(p->id, meta::PORT_NAME_INPUT) == 0)
-                    ++p_channels;
-                else
-                    ++m_channels;
-            }
+        static inline float max_gain(float old_gain, float gain)
+        {
+            return lsp_max(fabsf(old_gain), fabsf(gain));
+        }
+
+        static inline size_t add_source(mix::source_t *src, size_t n, const float *buf, float old_gain, float gain, float pre)
+        {
+            // Sources which are not connected or do not contribute to any signal over the whole block are skipped
+            if ((buf == NULL) || ((is_silent(old_gain, gain)) && (pre == 0.0f)))
+                return n;
+
+            mix::source_t *s    = &src[n];
+            s->vData            = buf;
+            s->fOldGain         = old_gain;
+            s->fGain            = gain;
+            s->fPre             = pre;
+
+            return n + 1;
+        }
+
+        static inline const float *offset_ptr(const float *buf, size_t offset)
+        {
+            return (buf != NULL) ? &buf[offset] : NULL;
+        }
+
+        static inline float *link_buffer(plug::IPort *port, size_t samples)
+        {
+            // The shared memory link is used only if it is connected and holds the data for the
+            // whole block, otherwise the mixer falls back to the local signal for this block
+            core::AudioBuffer *buf  = port->buffer<core::AudioBuffer>();
+            return ((buf != NULL) && (buf->active()) && (buf->size() >= samples)) ? buf->buffer() : NULL;
+        }
+
+        static inline float source_peak(const float *in, const float *ret, size_t count)
+        {
+            float peak          = dsp::abs_max(in, count);
+            if (ret != NULL)
+                peak               += dsp::abs_max(ret, count);
+            return peak;
+        }
+
+        // Read the CPU cycle counter (the virtual timer counter for AArch64), the frequency of
+        // the counter is measured against the wall clock over the profiling window
+        static inline uint64_t read_cycles()
+        {
+        #if defined(ARCH_X86)
+            return __rdtsc();
+        #elif defined(ARCH_AARCH64)
+            uint64_t value;
+            __asm__ __volatile__ ("mrs %0, cntvct_el0" : "=r" (value));
+            return value;
+        #else
+            return 0;
+        #endif /* ARCH_X86 */
+        }
 
+        //---------------------------------------------------------------------
+        // Settings utilities
+        // The setting follows the port only when the port value changes, so the setting
+        // recalled from the scene stays in effect until the control is touched
+        template <class T>
+        static inline bool take_setting(T *value, T *last, T port)
+        {
+            if (*last == port)
+                return false;
+            *last               = port;
+            const bool changed  = (*value != port);
+            *value              = port;
+            return changed;
+        }
+
+        //---------------------------------------------------------------------
+        // Implementation
+        mixer::mixer(const meta::plugin_t *meta, size_t p_channels, size_t m_channels):
+            Module(meta),
+            sSceneSync(this)
+        {
             vPChannels      = NULL;
             vMChannels      = NULL;
+            clear_strips();
             nPChannels      = p_channels;
             nMChannels      = m_channels;
+            nTileSize       = TILE_SIZE_MAX;
             bMonoOut        = false;
+            for (size_t j=0; j<2; ++j)
+                for (size_t k=0; k<2; ++k)
+                {
+                    sBalance.fOldGain[j][k] = (j == k) ? GAIN_AMP_0_DB : GAIN_AMP_M_INF_DB;
+                    sBalance.fGain[j][k]    = (j == k) ? GAIN_AMP_0_DB : GAIN_AMP_M_INF_DB;
+                }
             vWet[0]         = NULL;
             vWet[1]         = NULL;
             vTemp[0]        = NULL;
             vTemp[1]        = NULL;
+            vRamp[0]        = NULL;
+            vRamp[1]        = NULL;
+            nRampLength     = 0;
+            for (size_t i=0; i<BUS_CHANNELS; ++i)
+                vBus[i]         = NULL;
+            vRoutes         = NULL;
+            vSilent         = NULL;
+            nRoutes         = 0;
+            nSilent         = 0;
+            bRebuild        = false;
+            nSolo           = 0;
+            mix::init_settings(&sMaster);
+            mix::init_settings(&sMasterPort);
+
+            vPartial        = NULL;
+            bParallel       = (m_channels / p_channels) >= meta::mixer::PARALLEL_STRIPS_MIN;
+            nThreads        = 1;
+            nMtBlock        = meta::mixer::MT_BLOCK_DFL;
+            nRouteJobs      = 0;
+            nSilentJobs     = 0;
+            nMeterJobs      = 0;
+            nJobSamples     = 0;
+            pJobFunc        = process_job<0, 0>;
+
+            bProfile        = false;
+            nProfSamples    = 0;
+            nProfWindow     = 0;
+            nProfStart      = 0;
+            sProfStart.seconds  = 0;
+            sProfStart.nanos    = 0;
+            for (size_t i=0; i<PS_COUNT; ++i)
+            {
+                vProfCycles[i]  = 0;
+                vProfLoad[i]    = 0.0f;
+            }
+
+            bLoudness       = false;
+
+            vDelayed        = NULL;
+            nDelayed        = 0;
+            nLatency        = 0;
+
+            bBypass         = false;
+            nFadePos        = 0;
+            nFadeLength     = 0;
+            nSceneSave      = 0;
+            nSceneNames     = -1;
+            bSceneLoad      = true;
+            bSceneStore     = false;
+            bSceneRecall    = false;
 
             pBypass         = NULL;
             pMonoOut        = NULL;
             pBalance        = NULL;
+            pThreads        = NULL;
+            pMtBlock        = NULL;
+            for (size_t i=0; i<meta::mixer::VCAS; ++i)
+                vVcas[i]        = NULL;
+            pProfile        = NULL;
+            for (size_t i=0; i<PS_COUNT; ++i)
+                vProfMeters[i]  = NULL;
+            pLoudness       = NULL;
+            pScene          = NULL;
+            pSceneStore     = NULL;
+            pSceneRecall    = NULL;
+            pSceneFade      = NULL;
+            init_loudness(&sLoudness);
 
             pData           = NULL;
         }
@@ -103,31 +344,206 @@ namespace lsp
             do_destroy();
         }
 
+        size_t mixer::select_tile_size(size_t channels)
+        {
+            // The working set of one tile consists of the wet and temporary buffers, the
+            // sources of one strip (up to four for stereo), the subgroup and aux buses it
+            // is routed to and the primary input, output, send and return buffers
+            size_t floats           = channels * 2 + channels * 2 + channels + channels * meta::mixer::AUX_BUSES + channels * 4;
+            size_t tile             = TILE_SIZE_MAX;
+            while ((tile > TILE_SIZE_MIN) && (tile * floats * sizeof(float) > TILE_CACHE_SIZE))
+                tile                  >>= 1;
+
+            return tile;
+        }
+
+        void mixer::init_loudness(loudness_t *l)
+        {
+            l->pRms         = NULL;
+            l->pMomentary   = NULL;
+            l->pShortTerm   = NULL;
+            l->pTruePeak    = NULL;
+        }
+
         void mixer::init(plug::IWrapper *wrapper, plug::IPort **ports)
         {
             // Call parent class for initialization
             Module::init(wrapper, ports);
 
+            // Select the tile size
+            nTileSize               = select_tile_size(nPChannels);
+
             // Estimate the number of bytes to allocate
             size_t szof_pchannels   = align_size(sizeof(primary_channel_t) * nPChannels, DEFAULT_ALIGN);
             size_t szof_mchannels   = align_size(sizeof(mix_channel_t) * nMChannels, DEFAULT_ALIGN);
-            size_t szof_wet         = align_size(BUFFER_SIZE * sizeof(float), DEFAULT_ALIGN);
-            size_t szof_temp        = align_size(BUFFER_SIZE * sizeof(float), DEFAULT_ALIGN);
-            size_t alloc            = szof_pchannels + szof_mchannels + (szof_temp + szof_wet) * nPChannels;
+            size_t nstrips          = nMChannels / nPChannels;
+            size_t nbuses           = (AUX_BUS_FIRST + meta::mixer::AUX_BUSES) * nPChannels;
+            size_t szof_routes      = align_size(sizeof(route_t) * nstrips, DEFAULT_ALIGN);
+            size_t szof_silent      = align_size(sizeof(size_t) * nstrips, DEFAULT_ALIGN);
+            size_t szof_delayed     = align_size(sizeof(size_t) * nMChannels, DEFAULT_ALIGN);
+            size_t szof_strip_bufs  = align_size(sizeof(float *) * nMChannels, DEFAULT_ALIGN);
+            size_t szof_strip_state = align_size(sizeof(float) * nMChannels, DEFAULT_ALIGN);
+            size_t szof_wet         = align_size(nTileSize * sizeof(float), DEFAULT_ALIGN);
+            size_t szof_temp        = align_size(nTileSize * sizeof(float), DEFAULT_ALIGN);
+            size_t szof_group       = align_size(nTileSize * sizeof(float), DEFAULT_ALIGN);
+            size_t szof_ramp        = align_size(nTileSize * sizeof(float), DEFAULT_ALIGN);
+            size_t szof_partial     = (bParallel) ? align_size(sizeof(partial_bus_t) * meta::mixer::THREADS_MAX, DEFAULT_ALIGN) : 0;
+            size_t szof_bus         = (bParallel) ? align_size(MT_CHUNK_SIZE * sizeof(float), DEFAULT_ALIGN) : 0;
+            size_t alloc            = szof_pchannels + szof_mchannels + szof_routes + szof_silent + szof_delayed +
+                                      szof_strip_bufs * 2 + szof_strip_state * (STRIP_STATE_ARRAYS + FADE_ARRAYS * 2) +
+                                      (szof_temp + szof_wet) * nPChannels + szof_ramp * 2 +
+                                      szof_group * (meta::mixer::SUBGROUPS + meta::mixer::AUX_BUSES) * nPChannels +
+                                      szof_partial + szof_bus * nbuses * meta::mixer::THREADS_MAX;
 
             // Allocate memory-aligned data
             uint8_t *ptr            = alloc_aligned<uint8_t>(pData, alloc, DEFAULT_ALIGN);
             if (ptr == NULL)
                 return;
 
+            // Strip meters measure each mixer channel with the sample peak, the true peak is interpolated
+            // for bus meters of each bus and primary channel only
+            if (sStripMeters.init(nMChannels, false) != STATUS_OK)
+                return;
+            if (sBusMeters.init(nbuses, true) != STATUS_OK)
+                return;
+
+            // Delay lines are read by all tiles of the block in the serial mode or by all jobs in the parallel mode,
+            // the memory of lines is allocated when the sample rate is known
+            size_t span             = (bParallel) ? lsp_max(nTileSize, MT_CHUNK_SIZE) : nTileSize;
+            if (sDelays.init((nMChannels + nPChannels) * 2, span) != STATUS_OK)
+                return;
+            if (sScenes.init(meta::mixer::SCENES, nMChannels) != STATUS_OK)
+                return;
+            if (sSceneSync.sBank.init(meta::mixer::SCENES, nMChannels) != STATUS_OK)
+                return;
+            if (sParams.init(nstrips * SP_COUNT + MP_COUNT) != STATUS_OK)
+                return;
+
             // Initialize pointers
             vPChannels              = advance_ptr_bytes<primary_channel_t>(ptr, szof_pchannels);
             vMChannels              = advance_ptr_bytes<mix_channel_t>(ptr, szof_mchannels);
+            vRoutes                 = advance_ptr_bytes<route_t>(ptr, szof_routes);
+            vSilent                 = advance_ptr_bytes<size_t>(ptr, szof_silent);
+            vDelayed                = advance_ptr_bytes<size_t>(ptr, szof_delayed);
+            nDelayed                = 0;
+
+            strips_t *s             = &sStrips;
+            s->vIn                  = advance_ptr_bytes<float *>(ptr, szof_strip_bufs);
+            s->vRet                 = advance_ptr_bytes<float *>(ptr, szof_strip_bufs);
+            for (size_t j=0; j<2; ++j)
+            {
+                s->vOldGain[j]          = advance_ptr_bytes<float>(ptr, szof_strip_state);
+                s->vGain[j]             = advance_ptr_bytes<float>(ptr, szof_strip_state);
+            }
+            s->vOldPostGain         = advance_ptr_bytes<float>(ptr, szof_strip_state);
+            s->vPostGain            = advance_ptr_bytes<float>(ptr, szof_strip_state);
+            for (size_t j=0; j<meta::mixer::AUX_BUSES; ++j)
+            {
+                s->vOldSend[j]          = advance_ptr_bytes<float>(ptr, szof_strip_state);
+                s->vSend[j]             = advance_ptr_bytes<float>(ptr, szof_strip_state);
+            }
+            s->vOutLevel            = advance_ptr_bytes<float>(ptr, szof_strip_state);
+            s->vPan                 = advance_ptr_bytes<float>(ptr, szof_strip_state);
+            s->vBalance             = advance_ptr_bytes<float>(ptr, szof_strip_state);
+
+            for (size_t i=0; i<2; ++i)
+            {
+                scene_gains_t *g        = &vFade[i];
+                g->vGain[0]             = advance_ptr_bytes<float>(ptr, szof_strip_state);
+                g->vGain[1]             = advance_ptr_bytes<float>(ptr, szof_strip_state);
+                g->vPostGain            = advance_ptr_bytes<float>(ptr, szof_strip_state);
+                for (size_t j=0; j<meta::mixer::AUX_BUSES; ++j)
+                    g->vSend[j]             = advance_ptr_bytes<float>(ptr, szof_strip_state);
+            }
 
             for (size_t i=0; i<nPChannels; ++i)
             {
                 vWet[i]                 = advance_ptr_bytes<float>(ptr, szof_wet);
                 vTemp[i]                = advance_ptr_bytes<float>(ptr, szof_temp);
+                vBus[i]                 = vWet[i];
+            }
+
+            // The ramp shape of the full tile is built once, the shorter one is built on demand
+            vRamp[0]                = advance_ptr_bytes<float>(ptr, szof_ramp);
+            vRamp[1]                = advance_ptr_bytes<float>(ptr, szof_ramp);
+            mix::ramp_shape(vRamp[0], nTileSize);
+            nRampLength             = 0;
+
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+            {
+                subgroup_t *g           = &vSubgroups[i];
+
+                g->vData[0]             = NULL;
+                g->vData[1]             = NULL;
+                g->fOldGain             = GAIN_AMP_0_DB;
+                g->fGain                = GAIN_AMP_0_DB;
+                g->fOutLevel[0]         = 0.0f;
+                g->fOutLevel[1]         = 0.0f;
+                g->bActive              = false;
+
+                g->pMute                = NULL;
+                g->pGain                = NULL;
+                g->pOutLevel[0]         = NULL;
+                g->pOutLevel[1]         = NULL;
+                init_loudness(&g->sLoudness);
+
+                for (size_t j=0; j<nPChannels; ++j)
+                {
+                    g->vData[j]             = advance_ptr_bytes<float>(ptr, szof_group);
+                    vBus[(i + 1) * 2 + j]   = g->vData[j];
+                }
+            }
+
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+            {
+                aux_t *a                = &vAux[i];
+
+                a->vData[0]             = NULL;
+                a->vData[1]             = NULL;
+                a->vOut[0]              = NULL;
+                a->vOut[1]              = NULL;
+                a->fOldGain             = GAIN_AMP_0_DB;
+                a->fGain                = GAIN_AMP_0_DB;
+                a->fOutLevel[0]         = 0.0f;
+                a->fOutLevel[1]         = 0.0f;
+                a->bPre                 = false;
+                a->bActive              = false;
+
+                a->pOut[0]              = NULL;
+                a->pOut[1]              = NULL;
+                a->pPre                 = NULL;
+                a->pGain                = NULL;
+                a->pOutLevel[0]         = NULL;
+                a->pOutLevel[1]         = NULL;
+                init_loudness(&a->sLoudness);
+
+                for (size_t j=0; j<nPChannels; ++j)
+                {
+                    a->vData[j]             = advance_ptr_bytes<float>(ptr, szof_group);
+                    vBus[(AUX_BUS_FIRST + i) * 2 + j]   = a->vData[j];
+                }
+            }
+
+            if (bParallel)
+            {
+                vPartial                = advance_ptr_bytes<partial_bus_t>(ptr, szof_partial);
+                for (size_t i=0; i<meta::mixer::THREADS_MAX; ++i)
+                {
+                    partial_bus_t *b        = &vPartial[i];
+                    for (size_t j=0; j<BUS_CHANNELS; ++j)
+                        b->vData[j]             = NULL;
+                    b->bUsed                = false;
+
+                    for (size_t j=0; j<AUX_BUS_FIRST + meta::mixer::AUX_BUSES; ++j)
+                        for (size_t k=0; k<nPChannels; ++k)
+                            b->vData[j * 2 + k]     = advance_ptr_bytes<float>(ptr, szof_bus);
+                }
+
+                // All worker threads are spawned here, the processing thread only selects the number
+                // of active ones, the calling thread always processes jobs too
+                status_t res            = sWorkers.init(pJobFunc, this, meta::mixer::THREADS_MAX - 1);
+                if (res != STATUS_OK)
+                    lsp_warn("Parallel processing is limited to %d threads, error=%d", int(sWorkers.workers() + 1), int(res));
             }
 
             // Initialize channels
@@ -135,7 +551,9 @@ namespace lsp
             {
                 primary_channel_t *c = &vPChannels[i];
 
-                c->sBypass.construct();
+                c->sBypass.fGain    = 0.0f;
+                c->sBypass.fTarget  = 0.0f;
+                c->sBypass.fDelta   = 1.0f;
 
                 c->vIn          = NULL;
                 c->vOut         = NULL;
@@ -145,10 +563,12 @@ namespace lsp
                 c->fDry         = GAIN_AMP_0_DB;
                 c->fOldWet      = GAIN_AMP_0_DB;
                 c->fWet         = GAIN_AMP_0_DB;
-                c->fOldGain[0]  = GAIN_AMP_0_DB;
-                c->fOldGain[1]  = GAIN_AMP_0_DB;
-                c->fGain[0]     = GAIN_AMP_0_DB;
-                c->fGain[1]     = GAIN_AMP_0_DB;
+                c->fOldLink     = GAIN_AMP_0_DB;
+                c->fLink        = GAIN_AMP_0_DB;
+                c->fInLevel     = 0.0f;
+                c->fOutLevel    = 0.0f;
+                c->vHostIn      = NULL;
+                c->vHostRet     = NULL;
 
                 c->pIn          = NULL;
                 c->pOut         = NULL;
@@ -161,19 +581,41 @@ namespace lsp
                 c->pOutLevel    = NULL;
             }
 
+            for (size_t i=0; i<nMChannels; ++i)
+            {
+                s->vIn[i]       = NULL;
+                s->vRet[i]      = NULL;
+            }
+            for (size_t j=0; j<2; ++j)
+            {
+                dsp::fill(s->vOldGain[j], GAIN_AMP_M_INF_DB, nMChannels);
+                dsp::fill(s->vGain[j], GAIN_AMP_M_INF_DB, nMChannels);
+            }
+            dsp::fill(s->vOldPostGain, GAIN_AMP_0_DB, nMChannels);
+            dsp::fill(s->vPostGain, GAIN_AMP_0_DB, nMChannels);
+            for (size_t j=0; j<meta::mixer::AUX_BUSES; ++j)
+            {
+                dsp::fill_zero(s->vOldSend[j], nMChannels);
+                dsp::fill_zero(s->vSend[j], nMChannels);
+            }
+            dsp::fill_zero(s->vOutLevel, nMChannels);
+            dsp::fill_zero(s->vPan, nMChannels);
+            dsp::fill_zero(s->vBalance, nMChannels);
+
             for (size_t i=0; i<nMChannels; ++i)
             {
                 mix_channel_t *c = &vMChannels[i];
 
-                c->vIn          = NULL;
-                c->vRet         = NULL;
-                c->fOldGain[0]  = GAIN_AMP_M_INF_DB;
-                c->fOldGain[1]  = GAIN_AMP_M_INF_DB;
-                c->fGain[0]     = GAIN_AMP_M_INF_DB;
-                c->fGain[1]     = GAIN_AMP_M_INF_DB;
-                c->fOldPostGain = GAIN_AMP_0_DB;
-                c->fPostGain    = GAIN_AMP_0_DB;
-                c->bSolo        = false;
+                c->nGroup       = 0;
+                c->nProfCycles  = 0;
+                c->fProfLoad    = 0.0f;
+                mix::init_settings(&c->sSet);
+                mix::init_settings(&c->sPort);
+                c->fDelay       = 0.0f;
+                c->fRetLatency  = 0.0f;
+                c->bDirty       = true;
+                c->vHostIn      = NULL;
+                c->vHostRet     = NULL;
 
                 c->pIn          = NULL;
                 c->pRet         = NULL;
@@ -184,10 +626,18 @@ namespace lsp
                 c->pBalance     = NULL;
                 c->pOutGain     = NULL;
                 c->pOutLevel    = NULL;
+                c->pGroup       = NULL;
+                c->pVca         = NULL;
+                for (size_t j=0; j<meta::mixer::AUX_BUSES; ++j)
+                    c->pSend[j]     = NULL;
+                c->pProfLoad    = NULL;
+                init_loudness(&c->sLoudness);
+                c->pDelay       = NULL;
+                c->pRetLatency  = NULL;
             }
 
             for (size_t i=0; i<nPChannels; ++i)
-                dsp::fill_zero(vTemp[i], BUFFER_SIZE);
+                dsp::fill_zero(vTemp[i], nTileSize);
 
             // Bind ports
             lsp_trace("Binding ports");
@@ -232,6 +682,13 @@ namespace lsp
             for (size_t i=0; i<nPChannels; ++i)
                 BIND_PORT(vPChannels[i].pOutLevel);
 
+            // Bind parallel processing controls
+            if (bParallel)
+            {
+                BIND_PORT(pThreads);
+                BIND_PORT(pMtBlock);
+            }
+
             // Bind ports for audio processing channels
             if (nPChannels > 1)
             {
@@ -280,6 +737,116 @@ namespace lsp
                     BIND_PORT(c->pOutLevel);
                 }
             }
+
+            // Bind routing of channels
+            for (size_t i=0; i<nMChannels; i += nPChannels)
+            {
+                mix_channel_t *c        = &vMChannels[i];
+
+                BIND_PORT(c->pGroup);
+                BIND_PORT(c->pVca);
+
+                for (size_t j=1; j<nPChannels; ++j)
+                {
+                    c[j].pGroup             = c->pGroup;
+                    c[j].pVca               = c->pVca;
+                }
+            }
+
+            // Bind subgroups and VCA groups
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+            {
+                subgroup_t *g           = &vSubgroups[i];
+
+                BIND_PORT(g->pMute);
+                BIND_PORT(g->pGain);
+                for (size_t j=0; j<nPChannels; ++j)
+                    BIND_PORT(g->pOutLevel[j]);
+            }
+            for (size_t i=0; i<meta::mixer::VCAS; ++i)
+                BIND_PORT(vVcas[i]);
+
+            // Bind aux sends of channels and aux buses
+            for (size_t i=0; i<nMChannels; i += nPChannels)
+            {
+                mix_channel_t *c        = &vMChannels[i];
+
+                for (size_t k=0; k<meta::mixer::AUX_BUSES; ++k)
+                {
+                    BIND_PORT(c->pSend[k]);
+                    for (size_t j=1; j<nPChannels; ++j)
+                        c[j].pSend[k]           = c->pSend[k];
+                }
+            }
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+            {
+                aux_t *a                = &vAux[i];
+
+                for (size_t j=0; j<nPChannels; ++j)
+                    BIND_PORT(a->pOut[j]);
+                BIND_PORT(a->pPre);
+                BIND_PORT(a->pGain);
+                for (size_t j=0; j<nPChannels; ++j)
+                    BIND_PORT(a->pOutLevel[j]);
+            }
+
+            // Bind DSP load meters, the load of the stereo strip is reported by its left channel
+            BIND_PORT(pProfile);
+            for (size_t i=0; i<PS_COUNT; ++i)
+                BIND_PORT(vProfMeters[i]);
+            for (size_t i=0; i<nMChannels; i += nPChannels)
+                BIND_PORT(vMChannels[i].pProfLoad);
+
+            // Bind loudness meters, meters of the stereo strip are bound to its left channel
+            BIND_PORT(pLoudness);
+            BIND_PORT(sLoudness.pRms);
+            BIND_PORT(sLoudness.pMomentary);
+            BIND_PORT(sLoudness.pShortTerm);
+            BIND_PORT(sLoudness.pTruePeak);
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+            {
+                loudness_t *l           = &vSubgroups[i].sLoudness;
+                BIND_PORT(l->pRms);
+                BIND_PORT(l->pMomentary);
+                BIND_PORT(l->pShortTerm);
+                BIND_PORT(l->pTruePeak);
+            }
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+            {
+                loudness_t *l           = &vAux[i].sLoudness;
+                BIND_PORT(l->pRms);
+                BIND_PORT(l->pMomentary);
+                BIND_PORT(l->pShortTerm);
+                BIND_PORT(l->pTruePeak);
+            }
+            for (size_t i=0; i<nMChannels; i += nPChannels)
+            {
+                loudness_t *l           = &vMChannels[i].sLoudness;
+                BIND_PORT(l->pRms);
+                BIND_PORT(l->pMomentary);
+                BIND_PORT(l->pShortTerm);
+                BIND_PORT(l->pTruePeak);
+            }
+
+            // Bind alignment delays of strips
+            for (size_t i=0; i<nMChannels; i += nPChannels)
+            {
+                mix_channel_t *c        = &vMChannels[i];
+
+                BIND_PORT(c->pDelay);
+                BIND_PORT(c->pRetLatency);
+                for (size_t j=1; j<nPChannels; ++j)
+                {
+                    c[j].pDelay             = c->pDelay;
+                    c[j].pRetLatency        = c->pRetLatency;
+                }
+            }
+
+            // Bind scenes
+            BIND_PORT(pScene);
+            BIND_PORT(pSceneStore);
+            BIND_PORT(pSceneRecall);
+            BIND_PORT(pSceneFade);
         }
 
         void mixer::destroy()
@@ -290,12 +857,47 @@ namespace lsp
 
         void mixer::do_destroy()
         {
+            // Stop worker threads, cancel the scene task and wait for it before releasing the data they use,
+            // the scene bank is leaked rather than released under the task that does not finish in time
+            sWorkers.destroy();
+            atomic_store(&sSceneSync.nCancel, uatomic_t(1));
+            for (size_t i=0; (i < SCENE_SYNC_WAIT) && (!sSceneSync.idle()) && (!sSceneSync.completed()); ++i)
+                ipc::Thread::sleep(1);
+            if ((sSceneSync.idle()) || (sSceneSync.completed()))
+                sSceneSync.sBank.destroy();
+            else
+                lsp_warn("The scene task has not finished in %d ms, leaving its scene bank", int(SCENE_SYNC_WAIT));
+            sStripMeters.destroy();
+            sBusMeters.destroy();
+            sDelays.destroy();
+            sParams.destroy();
+            sScenes.destroy();
+
+            vPartial        = NULL;
             vPChannels      = NULL;
             vMChannels      = NULL;
+            clear_strips();
+            vRoutes         = NULL;
+            vSilent         = NULL;
+            vDelayed        = NULL;
             vWet[0]         = NULL;
             vWet[1]         = NULL;
             vTemp[0]        = NULL;
             vTemp[1]        = NULL;
+            vRamp[0]        = NULL;
+            vRamp[1]        = NULL;
+            for (size_t i=0; i<BUS_CHANNELS; ++i)
+                vBus[i]         = NULL;
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+            {
+                vSubgroups[i].vData[0]  = NULL;
+                vSubgroups[i].vData[1]  = NULL;
+            }
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+            {
+                vAux[i].vData[0]        = NULL;
+                vAux[i].vData[1]        = NULL;
+            }
 
             // Free previously allocated data chunk
             if (pData != NULL)
@@ -305,304 +907,1760 @@ namespace lsp
             }
         }
 
-        void mixer::update_sample_rate(long sr)
+        void mixer::clear_strips()
         {
-            for (size_t i=0; i<nPChannels; ++i)
+            strips_t *s     = &sStrips;
+            s->vIn          = NULL;
+            s->vRet         = NULL;
+            for (size_t j=0; j<2; ++j)
             {
-                primary_channel_t *c    = &vPChannels[i];
-                c->sBypass.init(sr);
+                s->vOldGain[j]  = NULL;
+                s->vGain[j]     = NULL;
+            }
+            s->vOldPostGain = NULL;
+            s->vPostGain    = NULL;
+            for (size_t j=0; j<meta::mixer::AUX_BUSES; ++j)
+            {
+                s->vOldSend[j]  = NULL;
+                s->vSend[j]     = NULL;
+            }
+            s->vOutLevel    = NULL;
+            s->vPan         = NULL;
+            s->vBalance     = NULL;
+
+            for (size_t i=0; i<2; ++i)
+            {
+                scene_gains_t *g    = &vFade[i];
+                g->vGain[0]     = NULL;
+                g->vGain[1]     = NULL;
+                g->vPostGain    = NULL;
+                for (size_t j=0; j<meta::mixer::AUX_BUSES; ++j)
+                    g->vSend[j]     = NULL;
             }
         }
 
-        void mixer::update_settings()
+        void mixer::update_sample_rate(long sr)
         {
-            bool bypass     = pBypass->value() >= 0.5f;
-
-            // Update settings for primary channels
             for (size_t i=0; i<nPChannels; ++i)
             {
                 primary_channel_t *c    = &vPChannels[i];
-                c->sBypass.set_bypass(bypass);
-
-                float out_gain          = c->pOutGain->value();
-                c->fOldDry              = c->fDry;
-                c->fDry                 = c->pDry->value() * out_gain;
-                c->fOldWet              = c->fWet;
-                c->fWet                 = c->pWet->value() * out_gain;
+                c->sBypass.fDelta       = 1.0f / lsp_max(BYPASS_TIME * sr, 1.0f);
             }
 
-            // Apply balance
-            if (nPChannels > 1)
-            {
-                primary_channel_t *l    = &vPChannels[0];
-                primary_channel_t *r    = &vPChannels[1];
-
-                float balance           = pBalance->value() * 0.01f;
-                float bal_l             = 1.0f - balance;
-                float bal_r             = 1.0f + balance;
-                float pan               = (pMonoOut->value() >= 0.5f) ? 0.5f : 1.0f;
+            nProfWindow     = lsp_max(size_t(dspu::seconds_to_samples(sr, PROFILE_WINDOW)), size_t(1));
+            reset_profile();
 
-                l->fOldGain[0]          = l->fGain[0];
-                l->fOldGain[1]          = l->fGain[1];
-                r->fOldGain[0]          = r->fGain[0];
-                r->fOldGain[1]          = r->fGain[1];
+            sStripMeters.set_sample_rate(sr);
+            sBusMeters.set_sample_rate(sr);
 
-                l->fGain[0]             = (pan) * bal_l;
-                l->fGain[1]             = (1.0f - pan) * bal_r;
-                r->fGain[0]             = (1.0f - pan) * bal_l;
-                r->fGain[1]             = (pan) * bal_r;
+            // Lines of channels also compensate latencies of return paths, lines of primary
+            // channels delay the input and the return by the reported latency
+            const size_t delay_max  = size_t(dspu::millis_to_samples(sr, meta::mixer::CHANNEL_DELAY_MAX));
+            for (size_t i=0; i<nPChannels; ++i)
+            {
+                sDelays.set_capacity((nMChannels + i) * 2, meta::mixer::RETURN_LATENCY_MAX);
+                sDelays.set_capacity((nMChannels + i) * 2 + 1, meta::mixer::RETURN_LATENCY_MAX);
             }
-            else
+            for (size_t i=0; i<nMChannels; ++i)
             {
-                primary_channel_t *c    = &vPChannels[0];
+                sDelays.set_capacity(i * 2, delay_max + meta::mixer::RETURN_LATENCY_MAX);
+                sDelays.set_capacity(i * 2 + 1, delay_max + meta::mixer::RETURN_LATENCY_MAX);
 
-                c->fOldGain[0]          = c->fGain[0];
-                c->fOldGain[1]          = c->fGain[1];
-
-                c->fGain[0]             = GAIN_AMP_0_DB;
-                c->fGain[1]             = GAIN_AMP_0_DB;
+                // Delays in samples depend on the sample rate
+                vMChannels[i].fDelay    = -1.0f;
+                vMChannels[i].bDirty    = true;
             }
+            if (sDelays.allocate() != STATUS_OK)
+                lsp_warn("Failed to allocate delay lines, channel delays are disabled");
+        }
 
-            // Check soloing option
-            bool has_solo   = false;
-            for (size_t i=0; i<nMChannels; ++i)
+        void mixer::update_settings()
+        {
+            bool bypass     = pBypass->value() >= 0.5f;
+
+            // Parallel processing settings
+            if (bParallel)
             {
-                mix_channel_t *c        = &vMChannels[i];
-                c->bSolo                = c->pSolo->value() >= 0.5f;
-                if (c->bSolo)
-                    has_solo                = true;
+                const size_t threads    = lsp_limit(size_t(pThreads->value()), meta::mixer::THREADS_MIN, meta::mixer::THREADS_MAX);
+                sWorkers.set_active(threads - 1);
+                nThreads                = sWorkers.active() + 1;
+                nMtBlock                = pMtBlock->value();
             }
 
-            // Update channel configuration
+            // Read channel settings, the solo state is tracked as the number of soloed channels
+            const bool had_solo     = nSolo > 0;
+            bool delays             = false;
             for (size_t i=0; i<nMChannels; ++i)
             {
                 mix_channel_t *c        = &vMChannels[i];
+                const bool solo         = c->sSet.bSolo;
+                const float delay       = c->fDelay;
+                const float latency     = c->fRetLatency;
+                if (!read_channel(c))
+                    continue;
 
-                bool mute               = (c->pMute->value() >= 0.5f) || ((has_solo) && (!c->bSolo));
-                float gain              = c->pOutGain->value();
-                float post_gain         = (mute) ? 0.0f : 1.0f;
-                if (c->pPhase->value() >= 0.5f)
-                    post_gain               = -post_gain;
-
-                c->fOldGain[0]          = c->fGain[0];
-                c->fOldGain[1]          = c->fGain[1];
-                c->fOldPostGain         = c->fPostGain;
-
-                c->fGain[0]             = gain;
-                c->fGain[1]             = gain;
-                c->fPostGain            = post_gain;
+                if (solo != c->sSet.bSolo)
+                    nSolo                   = (c->sSet.bSolo) ? nSolo + 1 : nSolo - 1;
+                if ((delay != c->fDelay) || (latency != c->fRetLatency))
+                    delays                  = true;
             }
 
-            // Additional stereo control for stereo mixer
-            if (nPChannels > 1)
+            // Read the master section, changed VCA gains affect all channels assigned to them
+            read_master();
+            for (size_t i=0; i<meta::mixer::VCAS; ++i)
             {
-                for (size_t i=0; i<nMChannels; i += 2)
-                {
-                    mix_channel_t *l        = &vMChannels[i];
-                    mix_channel_t *r        = &vMChannels[i+1];
+                if (!take_setting(&sMaster.vVca[i], &sMasterPort.vVca[i], vVcas[i]->value()))
+                    continue;
 
-                    float pan_l             = l->pPan->value() * 0.005f;
-                    float pan_r             = r->pPan->value() * 0.005f;
-                    float balance           = l->pBalance->value() * 0.01f;
-                    float bal_l             = 1.0f - balance;
-                    float bal_r             = 1.0f + balance;
+                for (size_t j=0; j<nMChannels; ++j)
+                    if (vMChannels[j].sSet.nVca == i + 1)
+                        vMChannels[j].bDirty    = true;
+            }
 
-                    l->fGain[0]            *= (0.5f - pan_l) * bal_l;
-                    l->fGain[1]            *= (0.5f + pan_l) * bal_r;
-                    r->fGain[0]            *= (0.5f - pan_r) * bal_l;
-                    r->fGain[1]            *= (0.5f + pan_r) * bal_r;
-                }
+            // Store and recall scenes on the rising edge of triggers, the recall replaces settings
+            // of the whole mix and cancels the crossfade of the previously recalled scene
+            const size_t scene      = lsp_min(size_t(pScene->value()), meta::mixer::SCENES - 1);
+            const bool store        = pSceneStore->value() >= 0.5f;
+            const bool recall       = pSceneRecall->value() >= 0.5f;
+            const float fade_time   = pSceneFade->value();
+            bool fade               = false;
+            if ((store) && (!bSceneStore))
+                store_scene(scene);
+            if ((recall) && (!bSceneRecall) && (recall_scene(scene)))
+            {
+                nFadeLength             = 0;
+                fade                    = fade_time > 0.0f;
+                if (fade)
+                    capture_gains(&vFade[0]);
             }
-        }
+            bSceneStore             = store;
+            bSceneRecall            = recall;
 
-        void mixer::process(size_t samples)
-        {
-            // Obtain audio buffers
-            for (size_t i=0; i<nPChannels; ++i)
+            // The change of the solo state affects all channels
+            const bool has_solo     = nSolo > 0;
+            if (has_solo != had_solo)
             {
-                primary_channel_t *c    = &vPChannels[i];
-                c->vIn                  = c->pIn->buffer<float>();
-                c->vOut                 = c->pOut->buffer<float>();
+                for (size_t i=0; i<nMChannels; ++i)
+                    vMChannels[i].bDirty    = true;
+            }
 
-                core::AudioBuffer *send = c->pSend->buffer<core::AudioBuffer>();
-                c->vSend                = ((send != NULL) && (send->active())) ? send->buffer() : NULL;
+            // Update the bypass state and gains of the mix
+            bBypass                 = bypass;
+            for (size_t i=0; i<nPChannels; ++i)
+                vPChannels[i].sBypass.fTarget   = (bypass) ? 1.0f : 0.0f;
+            update_gains(true);
 
-                core::AudioBuffer *ret  = c->pRet->buffer<core::AudioBuffer>();
-                c->vRet                 = ((ret!= NULL) && (ret->active())) ? ret->buffer() : NULL;
-            }
-            for (size_t i=0; i<nMChannels; ++i)
+            // Start the crossfade to gains of the recalled scene
+            if (fade)
             {
-                mix_channel_t *c        = &vMChannels[i];
-                c->vIn                  = c->pIn->buffer<float>();
-
-                core::AudioBuffer *ret  = c->pRet->buffer<core::AudioBuffer>();
-                c->vRet                 = ((ret!= NULL) && (ret->active())) ? ret->buffer() : NULL;
+                capture_gains(&vFade[1]);
+                nFadePos                = 0;
+                nFadeLength             = lsp_max(size_t(dspu::millis_to_samples(fSampleRate, fade_time)), size_t(1));
             }
 
-            // Main processing
-            while (samples > 0)
+            // Update alignment delays: the mix is delayed by the maximum latency of return paths which
+            // is reported to the host, each return is delayed by the rest of it to stay aligned with inputs
+            if (delays)
             {
-                size_t to_process           = lsp_min(samples, BUFFER_SIZE);
+                nLatency                = 0;
+                for (size_t i=0; i<nMChannels; ++i)
+                    nLatency                = lsp_max(nLatency, size_t(vMChannels[i].fRetLatency));
 
-                // Do the mixing stuff
-                if (nPChannels > 1)
+                nDelayed                = 0;
+                for (size_t i=0; i<nMChannels; ++i)
                 {
-                    // Stereo
-                    // Clear wet buffer
-                    dsp::fill_zero(vWet[0], samples);
-                    dsp::fill_zero(vWet[1], samples);
-
-                    // Apply mixing stuff
-                    for (size_t i=0; i<nMChannels; i += 2)
-                    {
-                        mix_channel_t *l        = &vMChannels[i];
-                        mix_channel_t *r        = &vMChannels[i+1];
-
-                        // Perform audio mixing of input stereo signal
-                        dsp::lramp2(vTemp[0], l->vIn, l->fOldGain[0], l->fGain[0], to_process);
-                        dsp::lramp2(vTemp[1], l->vIn, l->fOldGain[1], l->fGain[1], to_process);
-                        dsp::lramp_add2(vTemp[0], r->vIn, r->fOldGain[0], r->fGain[0], to_process);
-                        dsp::lramp_add2(vTemp[1], r->vIn, r->fOldGain[1], r->fGain[1], to_process);
-
-                        if (l->vRet != NULL)
-                        {
-                            dsp::lramp_add2(vTemp[0], l->vRet, l->fOldGain[0], l->fGain[0], to_process);
-                            dsp::lramp_add2(vTemp[1], l->vRet, l->fOldGain[1], l->fGain[1], to_process);
-                        }
-                        if (r->vRet != NULL)
-                        {
-                            dsp::lramp_add2(vTemp[0], r->vRet, r->fOldGain[0], r->fGain[0], to_process);
-                            dsp::lramp_add2(vTemp[1], r->vRet, r->fOldGain[1], r->fGain[1], to_process);
-                        }
-
-                        // Perform output level metering
-                        float out_l             = dsp::abs_max(vTemp[0], to_process);
-                        float out_r             = dsp::abs_max(vTemp[1], to_process);
-                        l->pOutLevel->set_value(out_l);
-                        r->pOutLevel->set_value(out_r);
-
-                        // Apply mixed channels to the wet signal
-                        dsp::lramp_add2(vWet[0], vTemp[0], l->fOldPostGain, l->fPostGain, to_process);
-                        dsp::lramp_add2(vWet[1], vTemp[1], r->fOldPostGain, r->fPostGain, to_process);
-
-                        // Renew old parameters
-                        l->fOldGain[0]          = l->fGain[0];
-                        l->fOldGain[1]          = l->fGain[1];
-                        l->fOldPostGain         = l->fPostGain;
-                        r->fOldGain[0]          = r->fGain[0];
-                        r->fOldGain[1]          = r->fGain[1];
-                        r->fOldPostGain         = r->fPostGain;
-                    }
+                    mix_channel_t *c        = &vMChannels[i];
+                    size_t delay            = size_t(dspu::millis_to_samples(fSampleRate, c->fDelay));
+                    size_t latency          = size_t(c->fRetLatency);
 
-                    // Mix dry/wet
-                    primary_channel_t *pl   = &vPChannels[0];
-                    primary_channel_t *pr   = &vPChannels[1];
-
-                    dsp::lramp2(vTemp[0], vWet[0], pl->fOldWet, pl->fWet, to_process);
-                    dsp::lramp2(vTemp[1], vWet[1], pr->fOldWet, pl->fWet, to_process);
-                    dsp::lramp_add2(vTemp[0], pl->vIn, pl->fOldDry, pl->fDry, to_process);
-                    dsp::lramp_add2(vTemp[1], pr->vIn, pr->fOldDry, pl->fDry, to_process);
-                    if (pl->vRet != NULL)
-                        dsp::lramp_add2(vTemp[0], pl->vRet, pl->fOldDry, pl->fDry, to_process);
-                    if (pr->vRet != NULL)
-                        dsp::lramp_add2(vTemp[1], pr->vRet, pr->fOldDry, pl->fDry, to_process);
-
-                    // Apply balance and mono
-                    dsp::lramp2(vWet[0], vTemp[0], pl->fOldGain[0], pl->fGain[0], to_process);
-                    dsp::lramp2(vWet[1], vTemp[0], pl->fOldGain[1], pl->fGain[1], to_process);
-                    dsp::lramp_add2(vWet[0], vTemp[1], pr->fOldGain[0], pr->fGain[0], to_process);
-                    dsp::lramp_add2(vWet[1], vTemp[1], pr->fOldGain[1], pr->fGain[1], to_process);
-
-                    // Renew old parameters
-                    pl->fOldWet     = pl->fWet;
-                    pl->fOldDry     = pl->fDry;
-                    pl->fOldGain[0] = pl->fGain[0];
-                    pl->fOldGain[1] = pl->fGain[1];
-                    pr->fOldWet     = pr->fWet;
-                    pr->fOldDry     = pr->fDry;
-                    pr->fOldGain[0] = pr->fGain[0];
-                    pr->fOldGain[1] = pr->fGain[1];
+                    sDelays.set_delay(i * 2, delay + nLatency);
+                    sDelays.set_delay(i * 2 + 1, delay + nLatency - latency);
+                    if ((sDelays.delay(i * 2) > 0) || (sDelays.delay(i * 2 + 1) > 0))
+                        vDelayed[nDelayed++]    = i;
                 }
-                else
+                for (size_t i=0; i<nPChannels; ++i)
                 {
-                    // Mono
-                    dsp::fill_zero(vWet[0], samples);
+                    sDelays.set_delay((nMChannels + i) * 2, nLatency);
+                    sDelays.set_delay((nMChannels + i) * 2 + 1, nLatency);
+                }
 
-                    // Apply mixing stuff
-                    for (size_t i=0; i<nMChannels; ++i)
-                    {
-                        mix_channel_t *c        = &vMChannels[i];
+                set_latency(nLatency);
+            }
 
-                        // Perform audio mixing of input mono signal
-                        dsp::lramp2(vTemp[0], c->vIn, c->fOldGain[0], c->fGain[0], to_process);
-                        if (c->vRet != NULL)
-                            dsp::lramp_add2(vTemp[0], c->vRet, c->fOldGain[0], c->fGain[0], to_process);
+            // Start the new profiling window when profiling gets enabled or disabled
+            bool profile            = (DSP_PROFILING) && (pProfile->value() >= 0.5f);
+            if (profile != bProfile)
+            {
+                bProfile                = profile;
+                reset_profile();
+            }
 
-                        // Perform output level metering
-                        float out               = dsp::abs_max(vTemp[0], to_process);
-                        c->pOutLevel->set_value(out);
+            // Start measurements from scratch when loudness metering gets enabled
+            bool loudness           = pLoudness->value() >= 0.5f;
+            if (loudness != bLoudness)
+            {
+                bLoudness               = loudness;
+                sStripMeters.clear();
+                sBusMeters.clear();
+            }
 
-                        // Apply mixed channels to the wet signal
-                        dsp::lramp_add2(vWet[0], vTemp[0], c->fOldPostGain, c->fPostGain, to_process);
+            // Compile the routing table
+            build_routes();
+        }
 
-                        // Renew old parameters
-                        c->fOldGain[0]          = c->fGain[0];
-                        c->fOldGain[1]          = c->fGain[1];
-                        c->fOldPostGain         = c->fPostGain;
-                    }
+        void mixer::update_gains(bool renew)
+        {
+            // The processed block renews old gains, so the gains changed at the start of
+            // the block by the parameter exchange ramp from the gains of the previous block
 
-                    // Mix dry/wet
-                    primary_channel_t *pc   = &vPChannels[0];
-                    dsp::lramp2(vWet[0], vWet[0], pc->fOldWet, pc->fWet, to_process);
-                    dsp::lramp_add2(vWet[0], pc->vIn, pc->fDry, pc->fOldDry, to_process);
-                    if (pc->vRet != NULL)
-                        dsp::lramp_add2(vWet[0], pc->vRet, pc->fDry, pc->fOldDry, to_process);
+            // Update settings for primary channels
+            for (size_t i=0; i<nPChannels; ++i)
+            {
+                primary_channel_t *c    = &vPChannels[i];
 
-                    // Renew old parameters
-                    pc->fOldWet     = pc->fWet;
-                    pc->fOldDry     = pc->fDry;
-                    pc->fOldGain[0] = pc->fGain[0];
-                    pc->fOldGain[1] = pc->fGain[1];
+                float out_gain          = sMaster.fOutGain;
+                if (renew)
+                {
+                    c->fOldDry              = c->fDry;
+                    c->fOldWet              = c->fWet;
                 }
+                c->fDry                 = snap_gain(sMaster.fDry * out_gain);
+                c->fWet                 = snap_gain(sMaster.fWet * out_gain);
+            }
 
-                // Apply bypass and metering
-                for (size_t i=0; i<nPChannels; ++i)
+            // Apply balance and mono fold-down to the output matrix
+            if (nPChannels > 1)
+            {
+                mix::matrix_t *m        = &sBalance;
+                float balance           = sMaster.fBalance * 0.01f;
+                float bal_l             = 1.0f - balance;
+                float bal_r             = 1.0f + balance;
+                float pan               = (sMaster.bMonoOut) ? 0.5f : 1.0f;
+
+                if (renew)
                 {
-                    primary_channel_t *c    = &vPChannels[i];
+                    for (size_t j=0; j<2; ++j)
+                        for (size_t k=0; k<2; ++k)
+                            m->fOldGain[j][k]       = m->fGain[j][k];
+                }
 
-                    const float *in         = c->vIn;
-                    if (c->vRet != NULL)
-                    {
-                        dsp::add3(vTemp[0], c->vIn, c->vRet, to_process);
-                        in                      = vTemp[0];
-                    }
+                m->fGain[0][0]          = (pan) * bal_l;
+                m->fGain[0][1]          = (1.0f - pan) * bal_l;
+                m->fGain[1][0]          = (1.0f - pan) * bal_r;
+                m->fGain[1][1]          = (pan) * bal_r;
+            }
 
-                    c->sBypass.process(c->vOut, in, vWet[i], to_process);
-                    if (c->vSend != NULL)
-                        dsp::copy(c->vSend, c->vOut, to_process);
+            // Update subgroups
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+            {
+                subgroup_t *g           = &vSubgroups[i];
+                if (renew)
+                    g->fOldGain             = g->fGain;
+                g->fGain                = (sMaster.vGroupMute[i]) ? 0.0f : snap_gain(sMaster.vGroupGain[i]);
+            }
 
-                    float in_lvl            = dsp::abs_max(in, to_process);
-                    float out_lvl           = dsp::abs_max(vWet[i], to_process);
+            // Update aux buses, outputs of aux buses are faded out in bypass mode
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+            {
+                aux_t *a                = &vAux[i];
+                if (renew)
+                    a->fOldGain             = a->fGain;
+                a->fGain                = (bBypass) ? 0.0f : snap_gain(sMaster.vAuxGain[i]);
+                a->bPre                 = sMaster.vAuxPre[i];
+            }
+
+            // Renew old gains of channels
+            if (renew)
+            {
+                strips_t *s             = &sStrips;
+                for (size_t j=0; j<2; ++j)
+                    dsp::copy(s->vOldGain[j], s->vGain[j], nMChannels);
+                dsp::copy(s->vOldPostGain, s->vPostGain, nMChannels);
+                for (size_t k=0; k<meta::mixer::AUX_BUSES; ++k)
+                    dsp::copy(s->vOldSend[k], s->vSend[k], nMChannels);
+            }
+
+            // Recompute gains of strips with changed settings only, the changed gains are not
+            // crossfaded any more if the crossfade of the recalled scene is in progress
+            const bool has_solo     = nSolo > 0;
+            for (size_t i=0; i<nMChannels; i += nPChannels)
+            {
+                bool dirty              = false;
+                for (size_t j=i; j<i + nPChannels; ++j)
+                    dirty                   = dirty || vMChannels[j].bDirty;
+                if (!dirty)
+                    continue;
+
+                update_strip(i, has_solo);
+                if (nFadeLength > 0)
+                    pin_strip_fade(i);
+            }
+            if (nFadeLength > 0)
+                pin_master_fade();
+        }
+
+        void mixer::apply_params()
+        {
+            if (!sParams.fetch())
+                return;
+
+            // Published gains replace settings in effect, ports take them over again when their controls are touched
+            float value;
+            for (size_t i=0, strip=0; i<nMChannels; i += nPChannels, ++strip)
+            {
+                bool dirty              = false;
+                if (sParams.take(strip_param(strip, SP_GAIN), &value))
+                {
+                    for (size_t j=i; j<i + nPChannels; ++j)
+                        vMChannels[j].sSet.fGain    = value;
+                    dirty                   = true;
+                }
+                for (size_t k=0; k<meta::mixer::AUX_BUSES; ++k)
+                {
+                    if (!sParams.take(strip_param(strip, SP_SEND + k), &value))
+                        continue;
+                    for (size_t j=i; j<i + nPChannels; ++j)
+                        vMChannels[j].sSet.vSend[k] = value;
+                    dirty                   = true;
+                }
+
+                if (dirty)
+                {
+                    for (size_t j=i; j<i + nPChannels; ++j)
+                        vMChannels[j].bDirty        = true;
+                }
+            }
+
+            mix::master_settings_t *m   = &sMaster;
+            if (sParams.take(master_param(MP_DRY), &value))
+                m->fDry                 = value;
+            if (sParams.take(master_param(MP_WET), &value))
+                m->fWet                 = value;
+            if (sParams.take(master_param(MP_OUT_GAIN), &value))
+                m->fOutGain             = value;
+            for (size_t i=0; i<meta::mixer::VCAS; ++i)
+            {
+                if (!sParams.take(master_param(MP_VCA + i), &value))
+                    continue;
+                m->vVca[i]              = value;
+                for (size_t j=0; j<nMChannels; ++j)
+                    if (vMChannels[j].sSet.nVca == i + 1)
+                        vMChannels[j].bDirty    = true;
+            }
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+            {
+                if (sParams.take(master_param(MP_GROUP + i), &value))
+                    m->vGroupGain[i]        = value;
+            }
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+            {
+                if (sParams.take(master_param(MP_AUX + i), &value))
+                    m->vAuxGain[i]          = value;
+            }
+
+            // Master gains are cheap to recompute, so any publication recomputes them,
+            // the gains ramp within the block as after the change of settings
+            update_gains(false);
+            build_routes();
+        }
+
+        void mixer::state_loaded()
+        {
+            // Scenes are stored in the KVT storage which has been restored with the state
+            bSceneLoad          = true;
+        }
+
+        bool mixer::read_channel(mix_channel_t *c)
+        {
+            mix::strip_settings_t *s    = &c->sSet;
+            mix::strip_settings_t *p    = &c->sPort;
+            const float pan         = (c->pPan != NULL) ? c->pPan->value() : 0.0f;
+            const float balance     = (c->pBalance != NULL) ? c->pBalance->value() : 0.0f;
+            const float delay       = c->pDelay->value();
+            const float latency     = c->pRetLatency->value();
+
+            bool changed            = false;
+            changed                 = take_setting(&s->bSolo, &p->bSolo, c->pSolo->value() >= 0.5f) || changed;
+            changed                 = take_setting(&s->bMute, &p->bMute, c->pMute->value() >= 0.5f) || changed;
+            changed                 = take_setting(&s->bPhase, &p->bPhase, c->pPhase->value() >= 0.5f) || changed;
+            changed                 = take_setting(&s->nVca, &p->nVca, uint32_t(lsp_min(size_t(c->pVca->value()), meta::mixer::VCAS))) || changed;
+            changed                 = take_setting(&s->nGroup, &p->nGroup, uint32_t(lsp_min(size_t(c->pGroup->value()), meta::mixer::SUBGROUPS))) || changed;
+            changed                 = take_setting(&s->fGain, &p->fGain, c->pOutGain->value()) || changed;
+            changed                 = take_setting(&s->fPan, &p->fPan, pan) || changed;
+            changed                 = take_setting(&s->fBalance, &p->fBalance, balance) || changed;
+            for (size_t k=0; k<meta::mixer::AUX_BUSES; ++k)
+                changed                 = take_setting(&s->vSend[k], &p->vSend[k], c->pSend[k]->value()) || changed;
+
+            // Alignment delays are not a part of the scene
+            changed                 = changed || (delay != c->fDelay) || (latency != c->fRetLatency);
+            c->fDelay               = delay;
+            c->fRetLatency          = latency;
+            c->bDirty               = c->bDirty || changed;
+
+            return changed;
+        }
+
+        void mixer::read_master()
+        {
+            mix::master_settings_t *m   = &sMaster;
+            mix::master_settings_t *p   = &sMasterPort;
+            const primary_channel_t *c  = &vPChannels[0];
+
+            take_setting(&m->fDry, &p->fDry, c->pDry->value());
+            take_setting(&m->fWet, &p->fWet, c->pWet->value());
+            take_setting(&m->fOutGain, &p->fOutGain, c->pOutGain->value());
+            if (nPChannels > 1)
+            {
+                take_setting(&m->fBalance, &p->fBalance, pBalance->value());
+                take_setting(&m->bMonoOut, &p->bMonoOut, pMonoOut->value() >= 0.5f);
+            }
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+            {
+                const subgroup_t *g     = &vSubgroups[i];
+                take_setting(&m->vGroupMute[i], &p->vGroupMute[i], g->pMute->value() >= 0.5f);
+                take_setting(&m->vGroupGain[i], &p->vGroupGain[i], g->pGain->value());
+            }
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+            {
+                const aux_t *a          = &vAux[i];
+                take_setting(&m->vAuxGain[i], &p->vAuxGain[i], a->pGain->value());
+                take_setting(&m->vAuxPre[i], &p->vAuxPre[i], a->pPre->value() >= 0.5f);
+            }
+        }
+
+        void mixer::update_strip(size_t first, bool has_solo)
+        {
+            strips_t *s             = &sStrips;
+
+            // VCA gain is applied directly to the channel fader
+            for (size_t i=first; i<first + nPChannels; ++i)
+            {
+                mix_channel_t *c        = &vMChannels[i];
+                const mix::strip_settings_t *set    = &c->sSet;
+
+                bool mute               = (set->bMute) || ((has_solo) && (!set->bSolo));
+                float post_gain         = (mute) ? 0.0f : 1.0f;
+                if (set->bPhase)
+                    post_gain               = -post_gain;
+                float vca               = (set->nVca > 0) ? sMaster.vVca[set->nVca - 1] : GAIN_AMP_0_DB;
+
+                s->vGain[0][i]          = set->fGain * vca;
+                s->vPostGain[i]         = post_gain;
+                for (size_t k=0; k<meta::mixer::AUX_BUSES; ++k)
+                    s->vSend[k][i]          = set->vSend[k];
+                c->nGroup               = set->nGroup;
+                c->bDirty               = false;
+            }
+
+            // Aux sends are taken after the mute and phase switches
+            for (size_t k=0; k<meta::mixer::AUX_BUSES; ++k)
+            {
+                mix::snap_gains(&s->vSend[k][first], GAIN_SNAP_THRESHOLD, nPChannels);
+                dsp::mul2(&s->vSend[k][first], &s->vPostGain[first], nPChannels);
+            }
+
+            // Apply panning and balance for stereo mixer, the balance of the strip is taken from the left channel
+            if (nPChannels > 1)
+            {
+                s->vPan[first]          = vMChannels[first].sSet.fPan * 0.005f;
+                s->vPan[first + 1]      = vMChannels[first + 1].sSet.fPan * 0.005f;
+                s->vBalance[first]      = vMChannels[first].sSet.fBalance * 0.01f;
+                s->vBalance[first + 1]  = s->vBalance[first];
+
+                mix::pan_gains(&s->vGain[0][first], &s->vGain[1][first], &s->vPan[first], &s->vBalance[first], nPChannels);
+                mix::snap_gains(&s->vGain[0][first], GAIN_SNAP_THRESHOLD, nPChannels);
+                mix::snap_gains(&s->vGain[1][first], GAIN_SNAP_THRESHOLD, nPChannels);
+            }
+            else
+            {
+                mix::snap_gains(&s->vGain[0][first], GAIN_SNAP_THRESHOLD, nPChannels);
+                dsp::copy(&s->vGain[1][first], &s->vGain[0][first], nPChannels);
+            }
+        }
+
+        void mixer::store_scene(size_t scene)
+        {
+            mix::strip_settings_t *strips   = sScenes.strips(scene);
+            for (size_t i=0; i<nMChannels; ++i)
+                strips[i]               = vMChannels[i].sSet;
+            *sScenes.master(scene)  = sMaster;
+            sScenes.commit(scene);
+
+            // The scene and names of channels are written to KVT by the offline task
+            nSceneSave             |= uint32_t(1) << scene;
+        }
+
+        bool mixer::recall_scene(size_t scene)
+        {
+            if (!sScenes.valid(scene))
+                return false;
+
+            // Settings in effect are replaced, ports take them over again when their controls are touched
+            const mix::strip_settings_t *strips = sScenes.strips(scene);
+            nSolo                   = 0;
+            for (size_t i=0; i<nMChannels; ++i)
+            {
+                mix_channel_t *c        = &vMChannels[i];
+                c->sSet                 = strips[i];
+                c->sSet.nVca            = lsp_min(c->sSet.nVca, uint32_t(meta::mixer::VCAS));
+                c->sSet.nGroup          = lsp_min(c->sSet.nGroup, uint32_t(meta::mixer::SUBGROUPS));
+                c->bDirty               = true;
+                if (c->sSet.bSolo)
+                    ++nSolo;
+            }
+            sMaster                 = *sScenes.master(scene);
+            nSceneNames             = scene;
+
+            return true;
+        }
+
+        void mixer::capture_gains(scene_gains_t *g)
+        {
+            const strips_t *s       = &sStrips;
+
+            for (size_t j=0; j<2; ++j)
+                dsp::copy(g->vGain[j], s->vGain[j], nMChannels);
+            dsp::copy(g->vPostGain, s->vPostGain, nMChannels);
+            for (size_t k=0; k<meta::mixer::AUX_BUSES; ++k)
+                dsp::copy(g->vSend[k], s->vSend[k], nMChannels);
+
+            for (size_t i=0; i<nPChannels; ++i)
+            {
+                g->fDry[i]              = vPChannels[i].fDry;
+                g->fWet[i]              = vPChannels[i].fWet;
+            }
+            for (size_t j=0; j<2; ++j)
+                for (size_t k=0; k<2; ++k)
+                    g->fBalance[j][k]       = sBalance.fGain[j][k];
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+                g->vGroup[i]            = vSubgroups[i].fGain;
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+                g->vAux[i]              = vAux[i].fGain;
+        }
+
+        // Replace both ends of the crossfade with the gain that has been changed by the control
+        template <class T>
+        static inline void pin_gain(T *from, T *to, T gain)
+        {
+            if (*to == gain)
+                return;
+            *from               = gain;
+            *to                 = gain;
+        }
+
+        void mixer::pin_strip_fade(size_t first)
+        {
+            const strips_t *s       = &sStrips;
+            scene_gains_t *f        = &vFade[0];
+            scene_gains_t *t        = &vFade[1];
+
+            for (size_t i=first; i<first + nPChannels; ++i)
+            {
+                for (size_t j=0; j<2; ++j)
+                    pin_gain(&f->vGain[j][i], &t->vGain[j][i], s->vGain[j][i]);
+                pin_gain(&f->vPostGain[i], &t->vPostGain[i], s->vPostGain[i]);
+                for (size_t k=0; k<meta::mixer::AUX_BUSES; ++k)
+                    pin_gain(&f->vSend[k][i], &t->vSend[k][i], s->vSend[k][i]);
+            }
+        }
+
+        void mixer::pin_master_fade()
+        {
+            scene_gains_t *f        = &vFade[0];
+            scene_gains_t *t        = &vFade[1];
+
+            for (size_t i=0; i<nPChannels; ++i)
+            {
+                pin_gain(&f->fDry[i], &t->fDry[i], vPChannels[i].fDry);
+                pin_gain(&f->fWet[i], &t->fWet[i], vPChannels[i].fWet);
+            }
+            for (size_t j=0; j<2; ++j)
+                for (size_t k=0; k<2; ++k)
+                    pin_gain(&f->fBalance[j][k], &t->fBalance[j][k], sBalance.fGain[j][k]);
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+                pin_gain(&f->vGroup[i], &t->vGroup[i], vSubgroups[i].fGain);
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+                pin_gain(&f->vAux[i], &t->vAux[i], vAux[i].fGain);
+        }
+
+        void mixer::advance_fade(size_t samples)
+        {
+            // The gains are interpolated once per tile (once per chunk in the parallel mode),
+            // the ramp of the tile moves them smoothly
+            nFadePos                = lsp_min(nFadePos + samples, nFadeLength);
+            const float k           = float(nFadePos) / float(nFadeLength);
+            const float kf          = 1.0f - k;
+            const scene_gains_t *f  = &vFade[0];
+            const scene_gains_t *t  = &vFade[1];
+            strips_t *s             = &sStrips;
+
+            for (size_t j=0; j<2; ++j)
+                dsp::mix_copy2(s->vGain[j], f->vGain[j], t->vGain[j], kf, k, nMChannels);
+            dsp::mix_copy2(s->vPostGain, f->vPostGain, t->vPostGain, kf, k, nMChannels);
+            for (size_t j=0; j<meta::mixer::AUX_BUSES; ++j)
+                dsp::mix_copy2(s->vSend[j], f->vSend[j], t->vSend[j], kf, k, nMChannels);
+
+            for (size_t i=0; i<nPChannels; ++i)
+            {
+                vPChannels[i].fDry      = f->fDry[i] * kf + t->fDry[i] * k;
+                vPChannels[i].fWet      = f->fWet[i] * kf + t->fWet[i] * k;
+            }
+            for (size_t j=0; j<2; ++j)
+                for (size_t l=0; l<2; ++l)
+                    sBalance.fGain[j][l]    = f->fBalance[j][l] * kf + t->fBalance[j][l] * k;
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+                vSubgroups[i].fGain     = f->vGroup[i] * kf + t->vGroup[i] * k;
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+                vAux[i].fGain           = f->vAux[i] * kf + t->vAux[i] * k;
+
+            // Drop strips and subgroups that became silent at the end of the crossfade
+            if (nFadePos >= nFadeLength)
+            {
+                nFadePos                = 0;
+                nFadeLength             = 0;
+                bRebuild                = true;
+            }
+        }
+
+        void mixer::sync_scenes()
+        {
+            // Scenes read from KVT replace stored scenes, scenes stored in the meantime are kept
+            if (sSceneSync.completed())
+            {
+                if (sSceneSync.bLoad)
+                {
+                    sScenes.swap(&sSceneSync.sBank);
+                    for (size_t i=0; i<meta::mixer::SCENES; ++i)
+                        if (nSceneSave & (uint32_t(1) << i))
+                            sScenes.copy(i, &sSceneSync.sBank);
+                }
+                sSceneSync.reset();
+            }
+
+            if ((!sSceneSync.idle()) || ((!bSceneLoad) && (nSceneSave == 0) && (nSceneNames < 0)))
+                return;
+            ipc::IExecutor *executor = pWrapper->executor();
+            if (executor == NULL)
+                return;
+
+            // The task writes copies of stored scenes, so they can be stored again while it runs
+            for (size_t i=0; i<meta::mixer::SCENES; ++i)
+                if (nSceneSave & (uint32_t(1) << i))
+                    sSceneSync.sBank.copy(i, &sScenes);
+            sSceneSync.nSave        = nSceneSave;
+            sSceneSync.nNames       = nSceneNames;
+            sSceneSync.bLoad        = bSceneLoad;
+            if (!executor->submit(&sSceneSync))
+                return;
+
+            nSceneSave              = 0;
+            nSceneNames             = -1;
+            bSceneLoad              = false;
+        }
+
+        //---------------------------------------------------------------------
+        // Exchange of scenes with the KVT storage
+        mixer::SceneSync::SceneSync(mixer *m)
+        {
+            pMixer          = m;
+            nSave           = 0;
+            nNames          = -1;
+            bLoad           = false;
+            nCancel         = 0;
+        }
+
+        mixer::SceneSync::~SceneSync()
+        {
+            pMixer          = NULL;
+        }
+
+        void mixer::SceneSync::save_scenes(core::KVTStorage *kvt, size_t strips)
+        {
+            char key[0x40], name[0x40];
+            const char *str;
+
+            // Write stored scenes, names of channels are saved with them
+            for (size_t i=0; i<meta::mixer::SCENES; ++i)
+            {
+                if (!(nSave & (uint32_t(1) << i)))
+                    continue;
+
+                core::kvt_param_t blob;
+                blob.type               = core::KVT_BLOB;
+                blob.blob.ctype         = "application/x-lsp-mixer-scene";
+                blob.blob.data          = sBank.serialize(i);
+                blob.blob.size          = sBank.blob_size();
+                snprintf(key, sizeof(key), "/scene/%d/data", int(i + 1));
+                kvt->put(key, &blob, core::KVT_TO_UI);
+
+                for (size_t j=0; j<strips; ++j)
+                {
+                    snprintf(name, sizeof(name), "/channel/%d/name", int(j + 1));
+                    snprintf(key, sizeof(key), "/scene/%d/channel/%d/name", int(i + 1), int(j + 1));
+                    if (kvt->get(name, &str) == STATUS_OK)
+                        kvt->put(key, str, core::KVT_TO_UI);
+                    else
+                        kvt->remove(key);
+                }
+            }
+        }
+
+        void mixer::SceneSync::restore_names(core::KVTStorage *kvt, size_t strips)
+        {
+            char key[0x40], name[0x40];
+            const char *str;
+
+            // Restore names of channels of the recalled scene
+            for (size_t j=0; j<strips; ++j)
+            {
+                snprintf(key, sizeof(key), "/scene/%d/channel/%d/name", int(nNames + 1), int(j + 1));
+                snprintf(name, sizeof(name), "/channel/%d/name", int(j + 1));
+                if (kvt->get(key, &str) == STATUS_OK)
+                    kvt->put(name, str, core::KVT_TO_UI);
+            }
+        }
+
+        void mixer::SceneSync::load_scenes(core::KVTStorage *kvt)
+        {
+            char key[0x40];
+            const core::kvt_param_t *p;
+
+            // Read scenes restored with the state of the plugin
+            sBank.clear();
+            for (size_t i=0; i<meta::mixer::SCENES; ++i)
+            {
+                snprintf(key, sizeof(key), "/scene/%d/data", int(i + 1));
+                if ((kvt->get(key, &p, core::KVT_BLOB) == STATUS_OK) && (p->blob.data != NULL))
+                    sBank.deserialize(i, p->blob.data, p->blob.size);
+            }
+        }
+
+        status_t mixer::SceneSync::run()
+        {
+            if (atomic_load(&nCancel))
+                return STATUS_CANCELLED;
+            core::KVTStorage *kvt   = pMixer->pWrapper->kvt_lock();
+            if (kvt == NULL)
+                return STATUS_OK;
+            if (atomic_load(&nCancel))
+            {
+                pMixer->pWrapper->kvt_release();
+                return STATUS_CANCELLED;
+            }
+
+            // Scenes are written before they are read, so the read scenes include them
+            const size_t strips     = pMixer->nMChannels / pMixer->nPChannels;
+            if (nSave != 0)
+                save_scenes(kvt, strips);
+            if (nNames >= 0)
+                restore_names(kvt, strips);
+            if (bLoad)
+                load_scenes(kvt);
+
+            pMixer->pWrapper->kvt_release();
+
+            return STATUS_OK;
+        }
+
+        void mixer::build_routes()
+        {
+            bool ramp               = false;
+
+            nRoutes                 = 0;
+            nSilent                 = 0;
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+            {
+                subgroup_t *g           = &vSubgroups[i];
+                g->bActive              = false;
+                ramp                    = ramp || (g->fOldGain != g->fGain);
+            }
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+                vAux[i].bActive         = false;
+
+            const strips_t *s       = &sStrips;
+            for (size_t i=0; i<nMChannels; i += nPChannels)
+            {
+                mix_channel_t *c        = &vMChannels[i];
+
+                // Collect aux buses the strip is sent to
+                uint8_t taps[meta::mixer::AUX_BUSES];
+                size_t ntaps            = 0;
+                for (size_t k=0; k<meta::mixer::AUX_BUSES; ++k)
+                {
+                    bool send               = false;
+                    for (size_t j=i; j<i + nPChannels; ++j)
+                    {
+                        send                    = send || (!is_silent(s->vOldSend[k][j], s->vSend[k][j]));
+                        ramp                    = ramp || (s->vOldSend[k][j] != s->vSend[k][j]);
+                    }
+                    if (send)
+                        taps[ntaps++]           = k;
+                }
+
+                // The strip is silent if all its channels are muted or it is routed to the muted
+                // subgroup and is not sent to any aux bus
+                bool silent             = true;
+                for (size_t j=i; j<i + nPChannels; ++j)
+                {
+                    silent                  = silent && is_silent(s->vOldPostGain[j], s->vPostGain[j]);
+                    ramp                    = ramp || (s->vOldPostGain[j] != s->vPostGain[j]);
+                }
+                subgroup_t *g           = (c->nGroup > 0) ? &vSubgroups[c->nGroup - 1] : NULL;
+                if ((g != NULL) && (is_silent(g->fOldGain, g->fGain)) && (ntaps <= 0))
+                    silent                  = true;
+
+                if (silent)
+                {
+                    vSilent[nSilent++]      = i;
+                    continue;
+                }
+
+                route_t *r              = &vRoutes[nRoutes++];
+                r->nChannel             = i;
+                r->nBus                 = c->nGroup;
+                r->nTaps                = ntaps;
+                for (size_t k=0; k<ntaps; ++k)
+                {
+                    r->vTaps[k]             = taps[k];
+                    vAux[taps[k]].bActive   = true;
+                }
+                if (g != NULL)
+                    g->bActive              = true;
+            }
+
+            // The set of audible strips may change when gain transitions complete
+            bRebuild                = ramp;
+        }
+
+        void mixer::bind_buffers(size_t samples)
+        {
+            for (size_t i=0; i<nPChannels; ++i)
+            {
+                primary_channel_t *c    = &vPChannels[i];
+                c->vIn                  = c->pIn->buffer<float>();
+                c->vOut                 = c->pOut->buffer<float>();
+                c->vSend                = link_buffer(c->pSend, samples);
+                c->vRet                 = link_buffer(c->pRet, samples);
+                c->vHostIn              = c->vIn;
+                c->vHostRet             = c->vRet;
+
+                // The return of the upstream mixer is faded in when the link comes up,
+                // there is no data left to fade it out when the link goes down
+                c->fLink                = (c->vRet != NULL) ? GAIN_AMP_0_DB : 0.0f;
+                if (c->vRet == NULL)
+                    c->fOldLink             = 0.0f;
+                c->fInLevel             = 0.0f;
+                c->fOutLevel            = 0.0f;
+            }
+            strips_t *s             = &sStrips;
+            for (size_t i=0; i<nMChannels; ++i)
+            {
+                mix_channel_t *c        = &vMChannels[i];
+                s->vIn[i]               = c->pIn->buffer<float>();
+                s->vRet[i]              = link_buffer(c->pRet, samples);
+                c->vHostIn              = s->vIn[i];
+                c->vHostRet             = s->vRet[i];
+            }
+            dsp::fill_zero(s->vOutLevel, nMChannels);
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+            {
+                subgroup_t *g           = &vSubgroups[i];
+                g->fOutLevel[0]         = 0.0f;
+                g->fOutLevel[1]         = 0.0f;
+            }
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+            {
+                aux_t *a                = &vAux[i];
+                for (size_t j=0; j<nPChannels; ++j)
+                    a->vOut[j]              = a->pOut[j]->buffer<float>();
+                a->fOutLevel[0]         = 0.0f;
+                a->fOutLevel[1]         = 0.0f;
+            }
+        }
+
+        void mixer::output_meters()
+        {
+            for (size_t i=0; i<nPChannels; ++i)
+            {
+                primary_channel_t *c    = &vPChannels[i];
+                c->pInLevel->set_value(c->fInLevel);
+                c->pOutLevel->set_value(c->fOutLevel);
+            }
+            for (size_t i=0; i<nMChannels; ++i)
+            {
+                mix_channel_t *c        = &vMChannels[i];
+                c->pOutLevel->set_value(sStrips.vOutLevel[i]);
+            }
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+            {
+                subgroup_t *g           = &vSubgroups[i];
+                for (size_t j=0; j<nPChannels; ++j)
+                    g->pOutLevel[j]->set_value(g->fOutLevel[j]);
+            }
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+            {
+                aux_t *a                = &vAux[i];
+                for (size_t j=0; j<nPChannels; ++j)
+                    a->pOutLevel[j]->set_value(a->fOutLevel[j]);
+            }
+
+            for (size_t i=0; i<PS_COUNT; ++i)
+                vProfMeters[i]->set_value(vProfLoad[i]);
+            for (size_t i=0; i<nMChannels; i += nPChannels)
+            {
+                mix_channel_t *c        = &vMChannels[i];
+                c->pProfLoad->set_value(c->fProfLoad);
+            }
+
+            // Subgroup buses are metered before the fader, apply the fader gain to the readings
+            output_loudness(&sLoudness, &sBusMeters, 0, nPChannels, GAIN_AMP_0_DB);
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+            {
+                subgroup_t *g           = &vSubgroups[i];
+                output_loudness(&g->sLoudness, &sBusMeters, (i + 1) * nPChannels, nPChannels, fabsf(g->fGain));
+            }
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+                output_loudness(&vAux[i].sLoudness, &sBusMeters, (AUX_BUS_FIRST + i) * nPChannels, nPChannels, GAIN_AMP_0_DB);
+            for (size_t i=0; i<nMChannels; i += nPChannels)
+                output_loudness(&vMChannels[i].sLoudness, &sStripMeters, i, nPChannels, GAIN_AMP_0_DB);
+        }
+
+        void mixer::output_loudness(const loudness_t *l, const mix::MeterBank *bank, size_t first, size_t n, float gain)
+        {
+            // RMS and true peak are reported for the loudest channel, loudness sums all channels
+            float rms               = 0.0f;
+            float momentary         = 0.0f;
+            float short_term        = 0.0f;
+            float peak              = 0.0f;
+
+            if (bLoudness)
+            {
+                for (size_t i=first; i<first + n; ++i)
+                {
+                    rms                     = lsp_max(rms, bank->rms(i));
+                    peak                    = lsp_max(peak, bank->true_peak(i));
+                    momentary              += bank->momentary(i);
+                    short_term             += bank->short_term(i);
+                }
+            }
+
+            l->pRms->set_value(rms * gain);
+            l->pMomentary->set_value(mix::MeterBank::loudness(momentary) * gain);
+            l->pShortTerm->set_value(mix::MeterBank::loudness(short_term) * gain);
+            l->pTruePeak->set_value(peak * gain);
+        }
+
+        void mixer::delay_strips(size_t count)
+        {
+            // Delayed channels read the input and the return directly from delay lines,
+            // the pointers to delay lines are overridden at the beginning of each span
+            strips_t *s             = &sStrips;
+            for (size_t i=0; i<nDelayed; ++i)
+            {
+                const size_t id         = vDelayed[i];
+                mix_channel_t *c        = &vMChannels[id];
+
+                float *buf              = sDelays.process(id * 2, c->vHostIn, count);
+                if (buf != NULL)
+                    s->vIn[id]              = buf;
+                c->vHostIn             += count;
+
+                if (c->vHostRet == NULL)
+                    continue;
+                buf                     = sDelays.process(id * 2 + 1, c->vHostRet, count);
+                if (buf != NULL)
+                    s->vRet[id]             = buf;
+                c->vHostRet            += count;
+            }
+        }
+
+        void mixer::delay_primary(size_t count)
+        {
+            // The input and the return of primary channels are read from delay lines
+            // while the latency is reported, the dry path and the bypass stay aligned with the mix
+            if (nLatency == 0)
+                return;
+
+            for (size_t i=0; i<nPChannels; ++i)
+            {
+                primary_channel_t *c    = &vPChannels[i];
+                const size_t id         = nMChannels + i;
+
+                float *buf              = sDelays.process(id * 2, c->vHostIn, count);
+                if (buf != NULL)
+                    c->vIn                  = buf;
+                c->vHostIn             += count;
+
+                if (c->vHostRet == NULL)
+                    continue;
+                buf                     = sDelays.process(id * 2 + 1, c->vHostRet, count);
+                if (buf != NULL)
+                    c->vRet                 = buf;
+                c->vHostRet            += count;
+            }
+        }
+
+        void mixer::bind_strip_meters()
+        {
+            for (size_t i=0; i<nMChannels; ++i)
+                sStripMeters.bind(i, sStrips.vIn[i], sStrips.vRet[i]);
+        }
+
+        void mixer::meter_strips(size_t count)
+        {
+            // Strips are metered before the fader, so muted strips are metered too
+            bind_strip_meters();
+            sStripMeters.process(0, sStripMeters.groups(), 0, count);
+            sStripMeters.commit(count);
+        }
+
+        void mixer::meter_buses(size_t count)
+        {
+            // Buses without routed channels are not mixed, so they are metered as silence
+            for (size_t j=0; j<nPChannels; ++j)
+            {
+                sBusMeters.bind(j, vWet[j], NULL);
+                for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+                {
+                    subgroup_t *g           = &vSubgroups[i];
+                    sBusMeters.bind((i + 1) * nPChannels + j, (g->bActive) ? g->vData[j] : NULL, NULL);
+                }
+                for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+                {
+                    aux_t *a                = &vAux[i];
+                    sBusMeters.bind((AUX_BUS_FIRST + i) * nPChannels + j, (a->bActive) ? a->vOut[j] : NULL, NULL);
+                }
+            }
+
+            sBusMeters.process(0, sBusMeters.groups(), 0, count);
+            sBusMeters.commit(count);
+        }
+
+        void mixer::reset_profile()
+        {
+            nProfSamples            = 0;
+            nProfStart              = (DSP_PROFILING) ? read_cycles() : 0;
+            system::get_time(&sProfStart);
+            for (size_t i=0; i<PS_COUNT; ++i)
+            {
+                vProfCycles[i]          = 0;
+                vProfLoad[i]            = 0.0f;
+            }
+            for (size_t i=0; i<nMChannels; ++i)
+            {
+                mix_channel_t *c        = &vMChannels[i];
+                c->nProfCycles          = 0;
+                c->fProfLoad            = 0.0f;
+            }
+        }
+
+        void mixer::update_profile(size_t samples)
+        {
+            // Publish the average DSP load at the end of the profiling window
+            nProfSamples           += samples;
+            if (nProfSamples < nProfWindow)
+                return;
+
+            // The load is the percentage of the audio time of the window, the number of counter ticks
+            // per second is the ratio of ticks to the wall clock time elapsed since the window start,
+            // so it does not depend on the frequency of the counter
+            const uint64_t now      = read_cycles();
+            system::time_t ts;
+            system::get_time(&ts);
+            const double wall       = double(ts.seconds - sProfStart.seconds) + double(ssize_t(ts.nanos) - ssize_t(sProfStart.nanos)) * 1e-9;
+            const double ticks      = double(now - nProfStart);
+            const double audio      = double(nProfSamples) / fSampleRate;
+            const float k           = ((wall > 0.0) && (ticks > 0.0)) ? 100.0 * wall / (ticks * audio) : 0.0f;
+            nProfStart              = now;
+            sProfStart              = ts;
+            for (size_t i=0; i<PS_COUNT; ++i)
+            {
+                vProfLoad[i]            = vProfCycles[i] * k;
+                vProfCycles[i]          = 0;
+            }
+            for (size_t i=0; i<nMChannels; ++i)
+            {
+                mix_channel_t *c        = &vMChannels[i];
+                c->fProfLoad            = c->nProfCycles * k;
+                c->nProfCycles          = 0;
+            }
+            nProfSamples            = 0;
+        }
+
+        inline uint64_t mixer::prof_start() const
+        {
+            return ((DSP_PROFILING) && (bProfile)) ? read_cycles() : 0;
+        }
+
+        inline uint64_t mixer::prof_stop(size_t stage, uint64_t start)
+        {
+            if (!((DSP_PROFILING) && (bProfile)))
+                return 0;
+
+            const uint64_t now      = read_cycles();
+            vProfCycles[stage]     += now - start;
+            return now;
+        }
+
+        inline uint64_t mixer::prof_strip(size_t channel, uint64_t start) const
+        {
+            if (!((DSP_PROFILING) && (bProfile)))
+                return 0;
+
+            const uint64_t now      = read_cycles();
+            vMChannels[channel].nProfCycles    += now - start;
+            return now;
+        }
+
+        inline bool mixer::bus_active(size_t bus) const
+        {
+            if (bus <= 0)
+                return true;
+            return (bus < AUX_BUS_FIRST) ? vSubgroups[bus - 1].bActive : vAux[bus - AUX_BUS_FIRST].bActive;
+        }
+
+        void mixer::clear_buses(float * const *bus, size_t count)
+        {
+            for (size_t i=0; i<AUX_BUS_FIRST + meta::mixer::AUX_BUSES; ++i)
+            {
+                if (!bus_active(i))
+                    continue;
+                for (size_t j=0; j<nPChannels; ++j)
+                    dsp::fill_zero(bus[i * 2 + j], count);
+            }
+        }
+
+        void mixer::prepare_ramp(size_t count)
+        {
+            // Hosts usually keep the block size, so the shape of the shorter tile is rebuilt rarely
+            if ((count == nTileSize) || (count == nRampLength))
+                return;
+            mix::ramp_shape(vRamp[1], count);
+            nRampLength             = count;
+        }
+
+        inline const float *mixer::ramp(size_t count) const
+        {
+            // Gain transitions complete within the first tile of the block, later tiles of
+            // the block never read the ramp shape, even if it has a different length
+            return (count == nTileSize) ? vRamp[0] : vRamp[1];
+        }
+
+        inline void mixer::renew_strip(size_t i)
+        {
+            strips_t *s             = &sStrips;
+            s->vOldGain[0][i]       = s->vGain[0][i];
+            s->vOldGain[1][i]       = s->vGain[1][i];
+            s->vOldPostGain[i]      = s->vPostGain[i];
+            for (size_t k=0; k<meta::mixer::AUX_BUSES; ++k)
+                s->vOldSend[k][i]       = s->vSend[k][i];
+        }
+
+        template <size_t N>
+        void mixer::mix_mono_strips(float * const *bus, const route_t *routes, size_t n, size_t offset, size_t count)
+        {
+            mix::source_t src[2];
+            mix::tap_t taps[meta::mixer::AUX_BUSES];
+            strips_t *s             = &sStrips;
+
+            // The route table holds at most one route per strip, the end of the strip is the start of the next one
+            const size_t nr         = (N > 0) ? lsp_min(n, N) : n;
+            uint64_t ts             = prof_start();
+            for (size_t i=0; i<nr; ++i)
+            {
+                const route_t *r        = &routes[i];
+                const size_t c          = r->nChannel;
+
+                // The route stays in the table until the end of the block when the strip gets muted
+                if (is_silent(s->vOldPostGain[c], s->vPostGain[c]))
+                {
+                    meter_mono_strips(&r->nChannel, 1, offset, count);
+                    ts                      = prof_start();
+                    continue;
+                }
+
+                // Collect aux sends of the channel
+                float pre               = 0.0f;
+                for (size_t k=0; k<r->nTaps; ++k)
+                {
+                    const size_t id         = r->vTaps[k];
+                    mix::tap_t *t           = &taps[k];
+                    t->vData                = &bus[(AUX_BUS_FIRST + id) * 2][offset];
+                    t->fOldGain             = s->vOldSend[id][c];
+                    t->fGain                = s->vSend[id][c];
+                    t->bPre                 = vAux[id].bPre;
+                    if (t->bPre)
+                        pre                     = 1.0f;
+                }
+
+                // Mix the channel into the destination bus and aux buses and perform output level metering
+                size_t ns               = 0;
+                ns                      = add_source(src, ns, &s->vIn[c][offset], s->vOldGain[0][c], s->vGain[0][c], pre);
+                ns                      = add_source(src, ns, offset_ptr(s->vRet[c], offset), s->vOldGain[0][c], s->vGain[0][c], pre);
+
+                float out               = mix::bus_add_taps(&bus[r->nBus * 2][offset], src, ns, s->vOldPostGain[c], s->vPostGain[c], taps, r->nTaps, ramp(count), count);
+                s->vOutLevel[c]         = lsp_max(s->vOutLevel[c], out);
+
+                // Renew old parameters
+                renew_strip(c);
+
+                ts                      = prof_strip(c, ts);
+            }
+        }
+
+        template <size_t N>
+        void mixer::mix_stereo_strips(float * const *bus, const route_t *routes, size_t n, size_t offset, size_t count)
+        {
+            mix::matrix_t m;
+            mix::tap_t taps[meta::mixer::AUX_BUSES * 2];
+            strips_t *s             = &sStrips;
+
+            // The route table holds at most one route per pair of channels, the end of the strip is the start of the next one
+            const size_t nr         = (N > 0) ? lsp_min(n, N / 2) : n;
+            uint64_t ts             = prof_start();
+            for (size_t i=0; i<nr; ++i)
+            {
+                const route_t *rt       = &routes[i];
+                const size_t l          = rt->nChannel;
+                const size_t r          = l + 1;
+
+                // The route stays in the table until the end of the block when the strip gets muted
+                if ((is_silent(s->vOldPostGain[l], s->vPostGain[l])) && (is_silent(s->vOldPostGain[r], s->vPostGain[r])))
+                {
+                    meter_stereo_strips(&rt->nChannel, 1, offset, count);
+                    ts                      = prof_start();
+                    continue;
+                }
+
+                const float *in[4]      = {
+                    &s->vIn[l][offset], &s->vIn[r][offset],
+                    offset_ptr(s->vRet[l], offset), offset_ptr(s->vRet[r], offset) };
+
+                // Panning and balance of the pair form the gain matrix of the strip
+                for (size_t j=0; j<2; ++j)
+                    for (size_t k=0; k<2; ++k)
+                    {
+                        m.fOldGain[j][k]        = s->vOldGain[j][l + k];
+                        m.fGain[j][k]           = s->vGain[j][l + k];
+                    }
+
+                // Collect aux sends of both channels, the pre-fader signal of each output is the unpanned signal
+                // of the corresponding channel
+                for (size_t k=0; k<rt->nTaps; ++k)
+                {
+                    const size_t id         = rt->vTaps[k];
+                    for (size_t j=0; j<2; ++j)
+                    {
+                        mix::tap_t *t           = &taps[k*2 + j];
+                        t->vData                = &bus[(AUX_BUS_FIRST + id) * 2 + j][offset];
+                        t->fOldGain             = s->vOldSend[id][l + j];
+                        t->fGain                = s->vSend[id][l + j];
+                        t->bPre                 = vAux[id].bPre;
+                    }
+                }
 
-                    c->pInLevel->set_value(in_lvl);
-                    c->pOutLevel->set_value(out_lvl);
+                // Mix the stereo pair into the destination bus and aux buses and perform output level metering
+                float * const dst[2]    = { &bus[rt->nBus * 2][offset], &bus[rt->nBus * 2 + 1][offset] };
+                float out[2];
+                mix::matrix_add_taps(dst, in, &m, &s->vOldPostGain[l], &s->vPostGain[l], taps, rt->nTaps, ramp(count), count, out);
+                for (size_t j=0; j<2; ++j)
+                {
+                    const size_t c          = l + j;
+                    if (!is_silent(s->vOldPostGain[c], s->vPostGain[c]))
+                        s->vOutLevel[c]         = lsp_max(s->vOutLevel[c], out[j]);
                 }
 
-                // Update counters and pointers
-                samples                    -= to_process;
-                for (size_t i=0; i<nPChannels; ++i)
+                // Renew old parameters
+                renew_strip(l);
+                renew_strip(r);
+
+                ts                      = prof_strip(l, ts);
+            }
+        }
+
+        void mixer::meter_mono_strips(const size_t *list, size_t n, size_t offset, size_t count)
+        {
+            strips_t *s             = &sStrips;
+            uint64_t ts             = prof_start();
+
+            for (size_t i=0; i<n; ++i)
+            {
+                const size_t c          = list[i];
+
+                // Muted or soloed-out strip does not contribute to any bus, estimate the level only
+                float g                 = max_gain(s->vOldGain[0][c], s->vGain[0][c]);
+                float out               = ((MUTED_STRIP_METERING) && (g > 0.0f)) ?
+                                          g * source_peak(&s->vIn[c][offset], offset_ptr(s->vRet[c], offset), count) : 0.0f;
+                s->vOutLevel[c]         = lsp_max(s->vOutLevel[c], out);
+
+                // Renew old parameters
+                renew_strip(c);
+
+                ts                      = prof_strip(c, ts);
+            }
+        }
+
+        void mixer::meter_stereo_strips(const size_t *list, size_t n, size_t offset, size_t count)
+        {
+            strips_t *s             = &sStrips;
+            uint64_t ts             = prof_start();
+
+            for (size_t i=0; i<n; ++i)
+            {
+                const size_t l          = list[i];
+                const size_t r          = l + 1;
+
+                // Muted or soloed-out strip does not contribute to any bus, estimate the level only
+                float lvl[2]            = { 0.0f, 0.0f };
+                if (MUTED_STRIP_METERING)
                 {
-                    primary_channel_t *c    = &vPChannels[i];
-                    c->vIn                 += to_process;
-                    c->vOut                += to_process;
-                    if (c->vSend != NULL)
-                        c->vSend               += to_process;
-                    if (c->vRet != NULL)
-                        c->vRet                += to_process;
+                    float gl[2]             = { max_gain(s->vOldGain[0][l], s->vGain[0][l]), max_gain(s->vOldGain[1][l], s->vGain[1][l]) };
+                    float gr[2]             = { max_gain(s->vOldGain[0][r], s->vGain[0][r]), max_gain(s->vOldGain[1][r], s->vGain[1][r]) };
+                    float pl                = ((gl[0] > 0.0f) || (gl[1] > 0.0f)) ?
+                                              source_peak(&s->vIn[l][offset], offset_ptr(s->vRet[l], offset), count) : 0.0f;
+                    float pr                = ((gr[0] > 0.0f) || (gr[1] > 0.0f)) ?
+                                              source_peak(&s->vIn[r][offset], offset_ptr(s->vRet[r], offset), count) : 0.0f;
+
+                    lvl[0]                  = gl[0] * pl + gr[0] * pr;
+                    lvl[1]                  = gl[1] * pl + gr[1] * pr;
                 }
-                for (size_t i=0; i<nMChannels; ++i)
-                    vMChannels[i].vIn      += to_process;
+
+                s->vOutLevel[l]         = lsp_max(s->vOutLevel[l], lvl[0]);
+                s->vOutLevel[r]         = lsp_max(s->vOutLevel[r], lvl[1]);
+
+                // Renew old parameters
+                renew_strip(l);
+                renew_strip(r);
+
+                ts                      = prof_strip(l, ts);
+            }
+        }
+
+        void mixer::mix_subgroups(size_t count)
+        {
+            mix::source_t src;
+
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+            {
+                subgroup_t *g           = &vSubgroups[i];
+
+                // Apply the subgroup fader, add the subgroup bus to the master bus and meter it
+                if (g->bActive)
+                {
+                    for (size_t j=0; j<nPChannels; ++j)
+                    {
+                        src.vData               = g->vData[j];
+                        src.fOldGain            = g->fOldGain;
+                        src.fGain               = g->fGain;
+                        src.fPre                = 0.0f;
+
+                        float out               = mix::bus_add(vWet[j], &src, 1, GAIN_AMP_0_DB, GAIN_AMP_0_DB, ramp(count), count);
+                        g->fOutLevel[j]         = lsp_max(g->fOutLevel[j], out);
+                    }
+                }
+
+                // Renew old parameters
+                g->fOldGain             = g->fGain;
+            }
+        }
+
+        void mixer::mix_dry_wet(float *dst, const float *wet, primary_channel_t *c, size_t count)
+        {
+            const float old_gain[3] = { c->fOldWet, c->fOldDry, c->fOldDry * c->fOldLink };
+            const float gain[3]     = { c->fWet, c->fDry, c->fDry * c->fLink };
+
+            mix::dry_wet(dst, wet, c->vIn, c->vRet, old_gain, gain, ramp(count), count);
+
+            // Renew old parameters
+            c->fOldWet              = c->fWet;
+            c->fOldDry              = c->fDry;
+            c->fOldLink             = c->fLink;
+        }
+
+        void mixer::mix_mono_master(size_t count)
+        {
+            primary_channel_t *pc   = &vPChannels[0];
+
+            // Mix dry/wet, the return is read directly from the link buffer
+            mix_dry_wet(vWet[0], vWet[0], pc, count);
+        }
+
+        void mixer::mix_stereo_master(size_t count)
+        {
+            primary_channel_t *pl   = &vPChannels[0];
+            primary_channel_t *pr   = &vPChannels[1];
+
+            // Mix dry/wet, the returns are read directly from the link buffers
+            mix_dry_wet(vTemp[0], vWet[0], pl, count);
+            mix_dry_wet(vTemp[1], vWet[1], pr, count);
+
+            // Apply balance and mono
+            mix::matrix_t *m        = &sBalance;
+            mix::matrix_apply(vWet, vTemp, m, ramp(count), count);
+
+            // Renew old parameters
+            for (size_t j=0; j<2; ++j)
+                for (size_t k=0; k<2; ++k)
+                    m->fOldGain[j][k]       = m->fGain[j][k];
+        }
+
+        void mixer::aux_stage(size_t count)
+        {
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+            {
+                aux_t *a                = &vAux[i];
+
+                // Apply the aux gain and perform metering, unused aux buses output silence
+                for (size_t j=0; j<nPChannels; ++j)
+                {
+                    if (a->bActive)
+                    {
+                        mix::copy_gain(a->vOut[j], a->vData[j], a->fOldGain, a->fGain, ramp(count), count);
+                        a->fOutLevel[j]         = lsp_max(a->fOutLevel[j], dsp::abs_max(a->vOut[j], count));
+                    }
+                    else
+                        dsp::fill_zero(a->vOut[j], count);
+                }
+
+                // Renew old parameters
+                a->fOldGain             = a->fGain;
+            }
+        }
+
+        template <size_t P>
+        void mixer::output_stage(size_t count)
+        {
+            const size_t np         = (P > 0) ? P : nPChannels;
+
+            // Apply bypass, fill the send and perform metering in one pass, the host
+            // may pass the same buffer as the input (or the return) and the output
+            for (size_t i=0; i<np; ++i)
+            {
+                primary_channel_t *c    = &vPChannels[i];
+                float peak[2];
+
+                mix::output_pass(c->vOut, c->vSend, c->vIn, c->vRet, vWet[i], &c->sBypass, count, peak);
+
+                c->fInLevel             = lsp_max(c->fInLevel, peak[0]);
+                c->fOutLevel            = lsp_max(c->fOutLevel, peak[1]);
+            }
+        }
+
+        template <size_t P>
+        void mixer::advance_primary(size_t count)
+        {
+            const size_t np         = (P > 0) ? P : nPChannels;
+
+            for (size_t i=0; i<np; ++i)
+            {
+                primary_channel_t *c    = &vPChannels[i];
+                c->vIn                 += count;
+                c->vOut                += count;
+                if (c->vSend != NULL)
+                    c->vSend               += count;
+                if (c->vRet != NULL)
+                    c->vRet                += count;
+            }
+
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+            {
+                aux_t *a                = &vAux[i];
+                for (size_t j=0; j<np; ++j)
+                    a->vOut[j]             += count;
+            }
+        }
+
+        template <size_t N>
+        void mixer::advance_strips(size_t count)
+        {
+            const size_t nm         = (N > 0) ? N : nMChannels;
+
+            float **in              = sStrips.vIn;
+            float **ret             = sStrips.vRet;
+            for (size_t i=0; i<nm; ++i)
+            {
+                in[i]                  += count;
+                if (ret[i] != NULL)
+                    ret[i]                 += count;
+            }
+        }
+
+        template <size_t P, size_t N>
+        uint64_t mixer::mix_strips(size_t count)
+        {
+            const size_t np         = (P > 0) ? P : nPChannels;
+            uint64_t ts             = prof_start();
+
+            delay_strips(count);
+            delay_primary(count);
+            clear_buses(vBus, count);
+
+            if (np > 1)
+            {
+                mix_stereo_strips<N>(vBus, vRoutes, nRoutes, 0, count);
+                ts                      = prof_stop(PS_MIX, ts);
+                meter_stereo_strips(vSilent, nSilent, 0, count);
+            }
+            else
+            {
+                mix_mono_strips<N>(vBus, vRoutes, nRoutes, 0, count);
+                ts                      = prof_stop(PS_MIX, ts);
+                meter_mono_strips(vSilent, nSilent, 0, count);
+            }
+            ts                      = prof_stop(PS_METER, ts);
+
+            mix_subgroups(count);
+            return prof_stop(PS_GROUPS, ts);
+        }
+
+        template <size_t P>
+        void mixer::mix_master(size_t count)
+        {
+            const size_t np         = (P > 0) ? P : nPChannels;
+
+            if (np > 1)
+                mix_stereo_master(count);
+            else
+                mix_mono_master(count);
+        }
+
+        template <size_t P, size_t N>
+        void mixer::process_job(void *arg, size_t job, size_t worker)
+        {
+            mixer *self             = static_cast<mixer *>(arg);
+            const size_t samples    = self->nJobSamples;
+            const bool stereo       = ((P > 0) ? P : self->nPChannels) > 1;
+
+            // Jobs that follow metering jobs of silent strips perform loudness metering of strips
+            if (job >= self->nRouteJobs + self->nSilentJobs)
+            {
+                const size_t first      = (job - self->nRouteJobs - self->nSilentJobs) * MT_JOB_METER_GROUPS;
+                self->sStripMeters.process(first, MT_JOB_METER_GROUPS, 0, samples);
+                return;
+            }
+
+            // Jobs that follow mixing jobs perform metering of silent strips only
+            if (job >= self->nRouteJobs)
+            {
+                const size_t first      = (job - self->nRouteJobs) * MT_JOB_STRIPS;
+                const size_t n          = lsp_min(self->nSilent - first, MT_JOB_STRIPS);
+                const size_t *list      = &self->vSilent[first];
+
+                for (size_t offset=0; offset < samples; )
+                {
+                    size_t count            = lsp_min(samples - offset, self->nTileSize);
+                    if (stereo)
+                        self->meter_stereo_strips(list, n, offset, count);
+                    else
+                        self->meter_mono_strips(list, n, offset, count);
+                    offset                 += count;
+                }
+                return;
+            }
+
+            // The partial bus is cleared by the first job the thread takes in the batch
+            partial_bus_t *b        = &self->vPartial[worker];
+            if (!b->bUsed)
+            {
+                self->clear_buses(b->vData, samples);
+                b->bUsed                = true;
+            }
+
+            // Mix the range of routes into the partial bus of the thread
+            const size_t first      = job * MT_JOB_STRIPS;
+            const size_t n          = lsp_min(self->nRoutes - first, MT_JOB_STRIPS);
+            const route_t *routes   = &self->vRoutes[first];
+
+            for (size_t offset=0; offset < samples; )
+            {
+                size_t count            = lsp_min(samples - offset, self->nTileSize);
+                if (stereo)
+                    self->mix_stereo_strips<N>(b->vData, routes, n, offset, count);
+                else
+                    self->mix_mono_strips<N>(b->vData, routes, n, offset, count);
+                offset                 += count;
+            }
+        }
+
+        void mixer::reduce_buses(size_t offset, size_t count)
+        {
+            bool empty              = true;
+
+            for (size_t i=0; i<meta::mixer::THREADS_MAX; ++i)
+            {
+                partial_bus_t *b        = &vPartial[i];
+                if (!b->bUsed)
+                    continue;
+
+                for (size_t j=0; j<AUX_BUS_FIRST + meta::mixer::AUX_BUSES; ++j)
+                {
+                    if (!bus_active(j))
+                        continue;
+
+                    for (size_t k=0; k<nPChannels; ++k)
+                    {
+                        float *dst              = vBus[j * 2 + k];
+                        const float *src        = &b->vData[j * 2 + k][offset];
+                        if (empty)
+                            dsp::copy(dst, src, count);
+                        else
+                            dsp::add2(dst, src, count);
+                    }
+                }
+                empty                   = false;
+            }
+
+            if (empty)
+                clear_buses(vBus, count);
+        }
+
+        template <size_t P, size_t N>
+        void mixer::process_parallel(size_t samples)
+        {
+            // Mix strips into partial buses of threads
+            for (size_t i=0; i<meta::mixer::THREADS_MAX; ++i)
+                vPartial[i].bUsed       = false;
+            nJobSamples             = samples;
+            nRouteJobs              = (nRoutes + MT_JOB_STRIPS - 1) / MT_JOB_STRIPS;
+            nSilentJobs             = (nSilent + MT_JOB_STRIPS - 1) / MT_JOB_STRIPS;
+            nMeterJobs              = (bLoudness) ? (sStripMeters.groups() + MT_JOB_METER_GROUPS - 1) / MT_JOB_METER_GROUPS : 0;
+
+            // Jobs mix the chunk tile by tile and renew gains of strips after the first tile, so gain
+            // transitions of strips take the first tile as in the serial mode and do not depend on the
+            // number of threads or the chunk size
+            prepare_ramp(lsp_min(samples, nTileSize));
+
+            // Delays and metering of strips are performed for the whole batch and accounted as mixing
+            uint64_t ts             = prof_start();
+            delay_strips(samples);
+            if (bLoudness)
+                bind_strip_meters();
+            sWorkers.run(nRouteJobs + nSilentJobs + nMeterJobs);
+            ts                      = prof_stop(PS_MIX, ts);
+            if (bLoudness)
+                sStripMeters.commit(samples);
+            advance_strips<N>(samples);
+
+            // Reduce partial buses and process subgroups and the master section
+            for (size_t offset=0; offset < samples; )
+            {
+                size_t to_process       = lsp_min(samples - offset, nTileSize);
+                prepare_ramp(to_process);
+
+                delay_primary(to_process);
+                reduce_buses(offset, to_process);
+                ts                      = prof_stop(PS_MIX, ts);
+                mix_subgroups(to_process);
+                ts                      = prof_stop(PS_GROUPS, ts);
+                mix_master<P>(to_process);
+                ts                      = prof_stop(PS_MASTER, ts);
+                output_stage<P>(to_process);
+                ts                      = prof_stop(PS_BYPASS, ts);
+                aux_stage(to_process);
+                ts                      = prof_stop(PS_AUX, ts);
+                if (bLoudness)
+                {
+                    meter_buses(to_process);
+                    ts                      = prof_stop(PS_LOUDNESS, ts);
+                }
+
+                advance_primary<P>(to_process);
+                offset                 += to_process;
+            }
+        }
+
+        template <size_t P, size_t N>
+        void mixer::process_tiles(size_t samples)
+        {
+            const uint64_t t_total  = prof_start();
+            const size_t total      = samples;
+
+            // Subnormal values of decaying signals and filter states are flushed to zero
+            dsp::context_t ctx;
+            dsp::start(&ctx);
+
+            // Obtain audio buffers
+            bind_buffers(samples);
+
+            // Apply gains published by control threads and hand the exchange of scenes with the KVT
+            // storage over to the offline task, gains move along the crossfade of the recalled scene per tile
+            apply_params();
+            if ((bSceneLoad) || (nSceneSave != 0) || (nSceneNames >= 0) || (!sSceneSync.idle()))
+                sync_scenes();
+
+            // Strips are distributed between threads for large enough blocks only
+            const bool parallel     = (nThreads > 1) && (samples >= nMtBlock);
+
+            // Main processing
+            while (samples > 0)
+            {
+                if (parallel)
+                {
+                    size_t to_process       = lsp_min(samples, MT_CHUNK_SIZE);
+                    if (nFadeLength > 0)
+                        advance_fade(to_process);
+                    process_parallel<P, N>(to_process);
+                    samples                -= to_process;
+                    continue;
+                }
+
+                size_t to_process       = lsp_min(samples, nTileSize);
+                if (nFadeLength > 0)
+                    advance_fade(to_process);
+                prepare_ramp(to_process);
+
+                // Do the mixing stuff
+                uint64_t ts             = mix_strips<P, N>(to_process);
+
+                // Strip inputs are metered before any output is written since the host may share buffers
+                if (bLoudness)
+                {
+                    meter_strips(to_process);
+                    ts                      = prof_stop(PS_LOUDNESS, ts);
+                }
+
+                mix_master<P>(to_process);
+                ts                      = prof_stop(PS_MASTER, ts);
+
+                // Apply bypass and metering
+                output_stage<P>(to_process);
+                ts                      = prof_stop(PS_BYPASS, ts);
+                aux_stage(to_process);
+                ts                      = prof_stop(PS_AUX, ts);
+
+                if (bLoudness)
+                {
+                    meter_buses(to_process);
+                    prof_stop(PS_LOUDNESS, ts);
+                }
+
+                // Update counters and pointers
+                advance_primary<P>(to_process);
+                advance_strips<N>(to_process);
+                samples                -= to_process;
+            }
+
+            // Output level meters
+            output_meters();
+
+            // Drop strips and subgroups that became silent after the end of gain transition
+            if (bRebuild)
+                build_routes();
+
+            // Account the DSP load
+            if ((DSP_PROFILING) && (bProfile))
+            {
+                prof_stop(PS_TOTAL, t_total);
+                update_profile(total);
             }
+
+            dsp::finish(&ctx);
+        }
+
+        void mixer::process(size_t samples)
+        {
+            // Generic engine with the number of channels known at run time only
+            process_tiles<0, 0>(samples);
         }
 
         void mixer::dump(dspu::IStateDumper *v) const
@@ -612,7 +2670,13 @@ namespace lsp
             {
                 primary_channel_t *p = &vPChannels[i];
 
-                v->write_object("sBypass", &p->sBypass);
+                v->begin_object("sBypass", &p->sBypass, sizeof(mix::xfade_t));
+                {
+                    v->write("fGain", p->sBypass.fGain);
+                    v->write("fTarget", p->sBypass.fTarget);
+                    v->write("fDelta", p->sBypass.fDelta);
+                }
+                v->end_object();
                 v->write("vIn", p->vIn);
                 v->write("vOut", p->vOut);
                 v->write("vSend", p->vSend);
@@ -621,8 +2685,12 @@ namespace lsp
                 v->write("fDry", p->fDry);
                 v->write("fOldWet", p->fOldWet);
                 v->write("fWet", p->fWet);
-                v->writev("fOldGain", p->fOldGain, 2);
-                v->writev("fGain", p->fGain, 2);
+                v->write("fOldLink", p->fOldLink);
+                v->write("fLink", p->fLink);
+                v->write("fInLevel", p->fInLevel);
+                v->write("fOutLevel", p->fOutLevel);
+                v->write("vHostIn", p->vHostIn);
+                v->write("vHostRet", p->vHostRet);
 
                 v->write("pIn", p->pIn);
                 v->write("pOut", p->pOut);
@@ -641,13 +2709,16 @@ namespace lsp
             {
                 mix_channel_t *c = &vMChannels[i];
 
-                v->write("vIn", c->vIn);
-                v->write("vRet", c->vRet);
-                v->writev("fOldGain", c->fOldGain, 2);
-                v->writev("fGain", c->fGain, 2);
-                v->write("fOldPostGain", c->fOldPostGain);
-                v->write("fPostGain", c->fPostGain);
-                v->write("bSolo", c->bSolo);
+                v->write("nGroup", c->nGroup);
+                v->write("nProfCycles", c->nProfCycles);
+                v->write("fProfLoad", c->fProfLoad);
+                mix::dump_settings(v, "sSet", &c->sSet);
+                mix::dump_settings(v, "sPort", &c->sPort);
+                v->write("fDelay", c->fDelay);
+                v->write("fRetLatency", c->fRetLatency);
+                v->write("bDirty", c->bDirty);
+                v->write("vHostIn", c->vHostIn);
+                v->write("vHostRet", c->vHostRet);
 
                 v->write("pIn", c->pIn);
                 v->write("pRet", c->pRet);
@@ -658,12 +2729,160 @@ namespace lsp
                 v->write("pBalance", c->pBalance);
                 v->write("pOutGain", c->pOutGain);
                 v->write("pOutLevel", c->pOutLevel);
+                v->write("pGroup", c->pGroup);
+                v->write("pVca", c->pVca);
+                v->begin_array("pSend", c->pSend, meta::mixer::AUX_BUSES);
+                for (size_t j=0; j<meta::mixer::AUX_BUSES; ++j)
+                    v->write(c->pSend[j]);
+                v->end_array();
+                v->write("pProfLoad", c->pProfLoad);
+                dump_loudness(v, "sLoudness", &c->sLoudness);
+                v->write("pDelay", c->pDelay);
+                v->write("pRetLatency", c->pRetLatency);
+            }
+            v->end_array();
+
+            v->begin_array("vSubgroups", vSubgroups, meta::mixer::SUBGROUPS);
+            for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+            {
+                const subgroup_t *g = &vSubgroups[i];
+                v->begin_object(g, sizeof(subgroup_t));
+                {
+                    v->begin_array("vData", g->vData, 2);
+                    {
+                        v->write(g->vData[0]);
+                        v->write(g->vData[1]);
+                    }
+                    v->end_array();
+                    v->write("fOldGain", g->fOldGain);
+                    v->write("fGain", g->fGain);
+                    v->writev("fOutLevel", g->fOutLevel, 2);
+                    v->write("bActive", g->bActive);
+
+                    v->write("pMute", g->pMute);
+                    v->write("pGain", g->pGain);
+                    v->begin_array("pOutLevel", g->pOutLevel, 2);
+                    {
+                        v->write(g->pOutLevel[0]);
+                        v->write(g->pOutLevel[1]);
+                    }
+                    v->end_array();
+                    dump_loudness(v, "sLoudness", &g->sLoudness);
+                }
+                v->end_object();
+            }
+            v->end_array();
+
+            v->begin_array("vAux", vAux, meta::mixer::AUX_BUSES);
+            for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+            {
+                const aux_t *a = &vAux[i];
+                v->begin_object(a, sizeof(aux_t));
+                {
+                    v->begin_array("vData", a->vData, 2);
+                    {
+                        v->write(a->vData[0]);
+                        v->write(a->vData[1]);
+                    }
+                    v->end_array();
+                    v->begin_array("vOut", a->vOut, 2);
+                    {
+                        v->write(a->vOut[0]);
+                        v->write(a->vOut[1]);
+                    }
+                    v->end_array();
+                    v->write("fOldGain", a->fOldGain);
+                    v->write("fGain", a->fGain);
+                    v->writev("fOutLevel", a->fOutLevel, 2);
+                    v->write("bPre", a->bPre);
+                    v->write("bActive", a->bActive);
+
+                    v->begin_array("pOut", a->pOut, 2);
+                    {
+                        v->write(a->pOut[0]);
+                        v->write(a->pOut[1]);
+                    }
+                    v->end_array();
+                    v->write("pPre", a->pPre);
+                    v->write("pGain", a->pGain);
+                    v->begin_array("pOutLevel", a->pOutLevel, 2);
+                    {
+                        v->write(a->pOutLevel[0]);
+                        v->write(a->pOutLevel[1]);
+                    }
+                    v->end_array();
+                    dump_loudness(v, "sLoudness", &a->sLoudness);
+                }
+                v->end_object();
+            }
+            v->end_array();
+
+            const strips_t *s = &sStrips;
+            v->begin_object("sStrips", s, sizeof(strips_t));
+            {
+                v->begin_array("vIn", s->vIn, nMChannels);
+                for (size_t j=0; j<nMChannels; ++j)
+                    v->write(s->vIn[j]);
+                v->end_array();
+                v->begin_array("vRet", s->vRet, nMChannels);
+                for (size_t j=0; j<nMChannels; ++j)
+                    v->write(s->vRet[j]);
+                v->end_array();
+                v->writev("vOldGainL", s->vOldGain[0], nMChannels);
+                v->writev("vOldGainR", s->vOldGain[1], nMChannels);
+                v->writev("vGainL", s->vGain[0], nMChannels);
+                v->writev("vGainR", s->vGain[1], nMChannels);
+                v->writev("vOldPostGain", s->vOldPostGain, nMChannels);
+                v->writev("vPostGain", s->vPostGain, nMChannels);
+                v->begin_array("vOldSend", s->vOldSend, meta::mixer::AUX_BUSES);
+                for (size_t j=0; j<meta::mixer::AUX_BUSES; ++j)
+                    v->writev(s->vOldSend[j], nMChannels);
+                v->end_array();
+                v->begin_array("vSend", s->vSend, meta::mixer::AUX_BUSES);
+                for (size_t j=0; j<meta::mixer::AUX_BUSES; ++j)
+                    v->writev(s->vSend[j], nMChannels);
+                v->end_array();
+                v->writev("vOutLevel", s->vOutLevel, nMChannels);
+                v->writev("vPan", s->vPan, nMChannels);
+                v->writev("vBalance", s->vBalance, nMChannels);
+            }
+            v->end_object();
+
+            v->begin_array("vRoutes", vRoutes, nRoutes);
+            for (size_t i=0; i<nRoutes; ++i)
+            {
+                const route_t *r = &vRoutes[i];
+                v->begin_object(r, sizeof(route_t));
+                {
+                    v->write("nChannel", r->nChannel);
+                    v->write("nBus", r->nBus);
+                    v->write("nTaps", r->nTaps);
+                    v->writev("vTaps", r->vTaps, r->nTaps);
+                }
+                v->end_object();
             }
             v->end_array();
+            v->begin_array("vSilent", vSilent, nSilent);
+            for (size_t i=0; i<nSilent; ++i)
+                v->write(vSilent[i]);
+            v->end_array();
+            v->write("nRoutes", nRoutes);
+            v->write("nSilent", nSilent);
+            v->write("bRebuild", bRebuild);
+            v->write("nSolo", nSolo);
+            mix::dump_settings(v, "sMaster", &sMaster);
+            mix::dump_settings(v, "sMasterPort", &sMasterPort);
 
             v->write("nPChannels", nPChannels);
             v->write("nMChannels", nMChannels);
+            v->write("nTileSize", nTileSize);
             v->write("bMonoOut", bMonoOut);
+            v->begin_object("sBalance", &sBalance, sizeof(mix::matrix_t));
+            {
+                v->writev("fOldGain", &sBalance.fOldGain[0][0], 4);
+                v->writev("fGain", &sBalance.fGain[0][0], 4);
+            }
+            v->end_object();
             v->begin_array("vWet", vWet, 2);
             {
                 v->write(vWet[0]);
@@ -676,14 +2895,144 @@ namespace lsp
                 v->write(vTemp[1]);
             }
             v->end_array();
+            v->begin_array("vRamp", vRamp, 2);
+            {
+                v->write(vRamp[0]);
+                v->write(vRamp[1]);
+            }
+            v->end_array();
+            v->write("nRampLength", nRampLength);
+            v->begin_array("vBus", vBus, BUS_CHANNELS);
+            for (size_t i=0; i<BUS_CHANNELS; ++i)
+                v->write(vBus[i]);
+            v->end_array();
+
+            if (vPartial != NULL)
+            {
+                v->begin_array("vPartial", vPartial, meta::mixer::THREADS_MAX);
+                for (size_t i=0; i<meta::mixer::THREADS_MAX; ++i)
+                {
+                    partial_bus_t *b = &vPartial[i];
+                    v->begin_object(b, sizeof(partial_bus_t));
+                    {
+                        v->begin_array("vData", b->vData, BUS_CHANNELS);
+                        for (size_t j=0; j<BUS_CHANNELS; ++j)
+                            v->write(b->vData[j]);
+                        v->end_array();
+                        v->write("bUsed", b->bUsed);
+                    }
+                    v->end_object();
+                }
+                v->end_array();
+            }
+            else
+                v->write("vPartial", vPartial);
+            v->write("nWorkers", sWorkers.workers());
+            v->write("bParallel", bParallel);
+            v->write("nThreads", nThreads);
+            v->write("nMtBlock", nMtBlock);
+            v->write("nRouteJobs", nRouteJobs);
+            v->write("nSilentJobs", nSilentJobs);
+            v->write("nMeterJobs", nMeterJobs);
+            v->write("nJobSamples", nJobSamples);
+
+            v->write("bProfile", bProfile);
+            v->write("nProfSamples", nProfSamples);
+            v->write("nProfWindow", nProfWindow);
+            v->write("nProfStart", nProfStart);
+            v->writev("vProfCycles", vProfCycles, PS_COUNT);
+            v->writev("vProfLoad", vProfLoad, PS_COUNT);
+
+            v->write_object("sStripMeters", &sStripMeters);
+            v->write_object("sBusMeters", &sBusMeters);
+            v->write("bLoudness", bLoudness);
+
+            v->write_object("sDelays", &sDelays);
+            v->begin_array("vDelayed", vDelayed, nDelayed);
+            for (size_t i=0; i<nDelayed; ++i)
+                v->write(vDelayed[i]);
+            v->end_array();
+            v->write("nDelayed", nDelayed);
+            v->write("nLatency", nLatency);
+
+            v->write_object("sParams", &sParams);
+            v->write("bBypass", bBypass);
+            v->write_object("sScenes", &sScenes);
+            v->begin_array("vFade", vFade, 2);
+            for (size_t i=0; i<2; ++i)
+            {
+                const scene_gains_t *g  = &vFade[i];
+                v->begin_object(g, sizeof(scene_gains_t));
+                {
+                    v->writev("vGainL", g->vGain[0], nMChannels);
+                    v->writev("vGainR", g->vGain[1], nMChannels);
+                    v->writev("vPostGain", g->vPostGain, nMChannels);
+                    v->begin_array("vSend", g->vSend, meta::mixer::AUX_BUSES);
+                    for (size_t j=0; j<meta::mixer::AUX_BUSES; ++j)
+                        v->writev(g->vSend[j], nMChannels);
+                    v->end_array();
+                    v->writev("fDry", g->fDry, 2);
+                    v->writev("fWet", g->fWet, 2);
+                    v->writev("fBalance", &g->fBalance[0][0], 4);
+                    v->writev("vGroup", g->vGroup, meta::mixer::SUBGROUPS);
+                    v->writev("vAux", g->vAux, meta::mixer::AUX_BUSES);
+                }
+                v->end_object();
+            }
+            v->end_array();
+            v->write("nFadePos", nFadePos);
+            v->write("nFadeLength", nFadeLength);
+            v->write("nSceneSave", nSceneSave);
+            v->write("nSceneNames", nSceneNames);
+            v->write("bSceneLoad", bSceneLoad);
+            v->begin_object("sSceneSync", &sSceneSync, sizeof(SceneSync));
+            {
+                v->write_object("sBank", &sSceneSync.sBank);
+                v->write("nSave", sSceneSync.nSave);
+                v->write("nNames", sSceneSync.nNames);
+                v->write("bLoad", sSceneSync.bLoad);
+                v->write("nCancel", sSceneSync.nCancel);
+            }
+            v->end_object();
+            v->write("bSceneStore", bSceneStore);
+            v->write("bSceneRecall", bSceneRecall);
 
             v->write("pBypass", pBypass);
             v->write("pMonoOut", pMonoOut);
             v->write("pBalance", pBalance);
+            v->write("pThreads", pThreads);
+            v->write("pMtBlock", pMtBlock);
+            v->begin_array("vVcas", vVcas, meta::mixer::VCAS);
+            for (size_t i=0; i<meta::mixer::VCAS; ++i)
+                v->write(vVcas[i]);
+            v->end_array();
+            v->write("pProfile", pProfile);
+            v->begin_array("vProfMeters", vProfMeters, PS_COUNT);
+            for (size_t i=0; i<PS_COUNT; ++i)
+                v->write(vProfMeters[i]);
+            v->end_array();
+            v->write("pLoudness", pLoudness);
+            v->write("pScene", pScene);
+            v->write("pSceneStore", pSceneStore);
+            v->write("pSceneRecall", pSceneRecall);
+            v->write("pSceneFade", pSceneFade);
+            dump_loudness(v, "sLoudness", &sLoudness);
 
             v->write("pData", pData);
         }
 
+        void mixer::dump_loudness(dspu::IStateDumper *v, const char *name, const loudness_t *l)
+        {
+            v->begin_object(name, l, sizeof(loudness_t));
+            {
+                v->write("pRms", l->pRms);
+                v->write("pMomentary", l->pMomentary);
+                v->write("pShortTerm", l->pShortTerm);
+                v->write("pTruePeak", l->pTruePeak);
+            }
+            v->end_object();
+        }
+
     } /* namespace plugins */
 } /* namespace lsp */
 
@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#include <private/plugins/mixer_delays.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        namespace mix
+        {
+            DelayArena::DelayArena()
+            {
+                vLines          = NULL;
+                nLines          = 0;
+                nSpan           = 0;
+
+                pLines          = NULL;
+                pData           = NULL;
+            }
+
+            DelayArena::~DelayArena()
+            {
+                destroy();
+            }
+
+            status_t DelayArena::init(size_t lines, size_t span)
+            {
+                destroy();
+
+                size_t szof_lines       = align_size(sizeof(line_t) * lines, DEFAULT_ALIGN);
+                uint8_t *ptr            = alloc_aligned<uint8_t>(pLines, szof_lines, DEFAULT_ALIGN);
+                if (ptr == NULL)
+                    return STATUS_NO_MEM;
+
+                vLines                  = reinterpret_cast<line_t *>(ptr);
+                for (size_t i=0; i<lines; ++i)
+                {
+                    line_t *l               = &vLines[i];
+                    l->vData                = NULL;
+                    l->nCapacity            = 0;
+                    l->nLength              = 0;
+                    l->nHead                = 0;
+                    l->nDelay               = 0;
+                }
+
+                nLines                  = lines;
+                nSpan                   = span;
+
+                return STATUS_OK;
+            }
+
+            void DelayArena::destroy()
+            {
+                free_aligned(pData);
+                free_aligned(pLines);
+                vLines          = NULL;
+                nLines          = 0;
+                nSpan           = 0;
+            }
+
+            void DelayArena::set_capacity(size_t line, size_t capacity)
+            {
+                vLines[line].nCapacity  = capacity;
+            }
+
+            status_t DelayArena::allocate()
+            {
+                free_aligned(pData);
+
+                // Each line holds the ring of (capacity + span) samples and the mirrored head of the ring
+                size_t alloc            = 0;
+                for (size_t i=0; i<nLines; ++i)
+                {
+                    line_t *l               = &vLines[i];
+                    l->vData                = NULL;
+                    l->nLength              = 0;
+                    alloc                  += align_size(sizeof(float) * (l->nCapacity + nSpan * 2), DEFAULT_ALIGN);
+                }
+
+                uint8_t *ptr            = alloc_aligned<uint8_t>(pData, alloc, DEFAULT_ALIGN);
+                if (ptr == NULL)
+                    return STATUS_NO_MEM;
+
+                for (size_t i=0; i<nLines; ++i)
+                {
+                    line_t *l               = &vLines[i];
+                    l->vData                = reinterpret_cast<float *>(ptr);
+                    l->nLength              = l->nCapacity + nSpan;
+                    l->nDelay               = lsp_min(l->nDelay, l->nCapacity);
+                    ptr                    += align_size(sizeof(float) * (l->nCapacity + nSpan * 2), DEFAULT_ALIGN);
+                }
+
+                clear();
+
+                return STATUS_OK;
+            }
+
+            void DelayArena::clear()
+            {
+                for (size_t i=0; i<nLines; ++i)
+                {
+                    line_t *l               = &vLines[i];
+                    if (l->vData != NULL)
+                        dsp::fill_zero(l->vData, l->nLength + nSpan);
+                    l->nHead                = 0;
+                }
+            }
+
+            void DelayArena::set_delay(size_t line, size_t delay)
+            {
+                line_t *l               = &vLines[line];
+
+                // The line is not written while disabled, so it contains outdated data
+                const size_t limit      = (l->vData != NULL) ? l->nLength - nSpan : l->nCapacity;
+                delay                   = lsp_min(delay, limit);
+                if ((l->nDelay <= 0) && (delay > 0) && (l->vData != NULL))
+                {
+                    dsp::fill_zero(l->vData, l->nLength + nSpan);
+                    l->nHead                = 0;
+                }
+                l->nDelay               = delay;
+            }
+
+            float *DelayArena::process(size_t line, const float *src, size_t count)
+            {
+                line_t *l               = &vLines[line];
+                if ((l->nDelay <= 0) || (l->vData == NULL))
+                    return NULL;
+
+                float *buf              = l->vData;
+                const size_t len        = l->nLength;
+                const size_t head       = l->nHead;
+
+                // Write the data to the ring
+                const size_t n          = lsp_min(count, len - head);
+                dsp::copy(&buf[head], src, n);
+                if (n < count)
+                    dsp::copy(buf, &src[n], count - n);
+
+                // Update the mirrored head of the ring
+                if (head < nSpan)
+                    dsp::copy(&buf[len + head], &buf[head], lsp_min(n, nSpan - head));
+                if (n < count)
+                    dsp::copy(&buf[len], buf, count - n);
+
+                // The delayed data is contiguous since the span never exceeds the mirrored head
+                size_t tail             = head + len - l->nDelay;
+                if (tail >= len)
+                    tail                   -= len;
+                l->nHead                = (head + count < len) ? head + count : head + count - len;
+
+                return &buf[tail];
+            }
+
+            void DelayArena::dump(dspu::IStateDumper *v) const
+            {
+                v->begin_array("vLines", vLines, nLines);
+                {
+                    for (size_t i=0; i<nLines; ++i)
+                    {
+                        const line_t *l     = &vLines[i];
+
+                        v->begin_object(l, sizeof(line_t));
+                        {
+                            v->write("vData", l->vData);
+                            v->write("nCapacity", l->nCapacity);
+                            v->write("nLength", l->nLength);
+                            v->write("nHead", l->nHead);
+                            v->write("nDelay", l->nDelay);
+                        }
+                        v->end_object();
+                    }
+                }
+                v->end_array();
+
+                v->write("nLines", nLines);
+                v->write("nSpan", nSpan);
+                v->write("pLines", pLines);
+                v->write("pData", pData);
+            }
+
+        } /* namespace mix */
+    } /* namespace plugins */
+} /* namespace lsp */
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <private/plugins/mixer_exchange.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        namespace mix
+        {
+            // The middle slot index is packed together with the flag of the publication
+            // not yet fetched by the reader, so both are exchanged by one atomic swap
+            static constexpr uatomic_t SLOT_MASK        = 0x3U;
+            static constexpr uatomic_t SLOT_PUBLISHED   = 0x4U;
+
+            ParamExchange::ParamExchange()
+            {
+                for (size_t i=0; i<3; ++i)
+                {
+                    vSlots[i].vValue    = NULL;
+                    vSlots[i].vSerial   = NULL;
+                }
+                sShadow.vValue  = NULL;
+                sShadow.vSerial = NULL;
+                vTaken          = NULL;
+                nParams         = 0;
+                nBack           = 0;
+                nFront          = 0;
+                nMiddle         = 0;
+                nWriter         = 0;
+
+                pData           = NULL;
+            }
+
+            ParamExchange::~ParamExchange()
+            {
+                destroy();
+            }
+
+            status_t ParamExchange::init(size_t params)
+            {
+                destroy();
+
+                const size_t szof_values    = align_size(sizeof(float) * params, DEFAULT_ALIGN);
+                const size_t szof_serials   = align_size(sizeof(uint32_t) * params, DEFAULT_ALIGN);
+                const size_t alloc          = (szof_values + szof_serials) * 4 + szof_serials;
+
+                uint8_t *ptr            = alloc_aligned<uint8_t>(pData, alloc, DEFAULT_ALIGN);
+                if (ptr == NULL)
+                    return STATUS_NO_MEM;
+                ::memset(ptr, 0, alloc);
+
+                for (size_t i=0; i<3; ++i)
+                {
+                    vSlots[i].vValue        = advance_ptr_bytes<float>(ptr, szof_values);
+                    vSlots[i].vSerial       = advance_ptr_bytes<uint32_t>(ptr, szof_serials);
+                }
+                sShadow.vValue          = advance_ptr_bytes<float>(ptr, szof_values);
+                sShadow.vSerial         = advance_ptr_bytes<uint32_t>(ptr, szof_serials);
+                vTaken                  = advance_ptr_bytes<uint32_t>(ptr, szof_serials);
+                nParams                 = params;
+                nFront                  = 0;
+                nBack                   = 2;
+                atomic_store(&nMiddle, uatomic_t(1));
+                atomic_store(&nWriter, uatomic_t(0));
+
+                return STATUS_OK;
+            }
+
+            void ParamExchange::destroy()
+            {
+                free_aligned(pData);
+                for (size_t i=0; i<3; ++i)
+                {
+                    vSlots[i].vValue    = NULL;
+                    vSlots[i].vSerial   = NULL;
+                }
+                sShadow.vValue  = NULL;
+                sShadow.vSerial = NULL;
+                vTaken          = NULL;
+                nParams         = 0;
+            }
+
+            bool ParamExchange::begin()
+            {
+                return atomic_cas(&nWriter, uatomic_t(0), uatomic_t(1));
+            }
+
+            void ParamExchange::set(size_t index, float value)
+            {
+                sShadow.vValue[index]   = value;
+                ++sShadow.vSerial[index];
+            }
+
+            void ParamExchange::publish()
+            {
+                // The back slot gets the complete copy of changes, so the publication
+                // replaces previous ones without losing their changes
+                slot_t *s               = &vSlots[nBack];
+                ::memcpy(s->vValue, sShadow.vValue, sizeof(float) * nParams);
+                ::memcpy(s->vSerial, sShadow.vSerial, sizeof(uint32_t) * nParams);
+
+                const uatomic_t middle  = atomic_swap(&nMiddle, uatomic_t(nBack) | SLOT_PUBLISHED);
+                nBack                   = middle & SLOT_MASK;
+
+                atomic_store(&nWriter, uatomic_t(0));
+            }
+
+            bool ParamExchange::fetch()
+            {
+                if (!(atomic_load(&nMiddle) & SLOT_PUBLISHED))
+                    return false;
+
+                const uatomic_t middle  = atomic_swap(&nMiddle, uatomic_t(nFront));
+                nFront                  = middle & SLOT_MASK;
+                return true;
+            }
+
+            bool ParamExchange::take(size_t index, float *value)
+            {
+                const slot_t *s         = &vSlots[nFront];
+                if (s->vSerial[index] == vTaken[index])
+                    return false;
+
+                vTaken[index]           = s->vSerial[index];
+                *value                  = s->vValue[index];
+                return true;
+            }
+
+            void ParamExchange::dump(dspu::IStateDumper *v) const
+            {
+                v->begin_array("vSlots", vSlots, 3);
+                for (size_t i=0; i<3; ++i)
+                {
+                    const slot_t *s         = &vSlots[i];
+                    v->begin_object(s, sizeof(slot_t));
+                    {
+                        v->write("vValue", s->vValue);
+                        v->write("vSerial", s->vSerial);
+                    }
+                    v->end_object();
+                }
+                v->end_array();
+                v->begin_object("sShadow", &sShadow, sizeof(slot_t));
+                {
+                    v->write("vValue", sShadow.vValue);
+                    v->write("vSerial", sShadow.vSerial);
+                }
+                v->end_object();
+                v->write("vTaken", vTaken);
+                v->write("nParams", nParams);
+                v->write("nBack", nBack);
+                v->write("nFront", nFront);
+                v->write("nMiddle", nMiddle);
+                v->write("nWriter", nWriter);
+                v->write("pData", pData);
+            }
+
+        } /* namespace mix */
+    } /* namespace plugins */
+} /* namespace lsp */
@@ -0,0 +1,732 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/types.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#include <private/plugins/mixer_kernels.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        namespace mix
+        {
+            // The number of sources is known at compile time, so the inner loop
+            // gets unrolled and all gains and deltas stay in registers. The RAMP
+            // parameter selects between the constant-gain and the ramping loop
+            template <size_t N, bool RAMP>
+            static float mix_sources(float *dst, const source_t *src, float old_post, float post, const float *ramp, size_t count)
+            {
+                const float *s[N];
+                float g[N], dg[N];
+
+                for (size_t j=0; j<N; ++j)
+                {
+                    s[j]            = src[j].vData;
+                    g[j]            = (RAMP) ? src[j].fOldGain : src[j].fGain;
+                    dg[j]           = src[j].fGain - src[j].fOldGain;
+                }
+
+                float peak      = 0.0f;
+                if (RAMP)
+                {
+                    const float dp  = post - old_post;
+
+                    for (size_t i=0; i<count; ++i)
+                    {
+                        const float x   = ramp[i];
+                        float v         = 0.0f;
+                        for (size_t j=0; j<N; ++j)
+                            v              += s[j][i] * (g[j] + dg[j] * x);
+
+                        peak            = lsp_max(peak, fabsf(v));
+                        dst[i]         += v * (old_post + dp * x);
+                    }
+                }
+                else
+                {
+                    for (size_t i=0; i<count; ++i)
+                    {
+                        float v         = 0.0f;
+                        for (size_t j=0; j<N; ++j)
+                            v              += s[j][i] * g[j];
+
+                        peak            = lsp_max(peak, fabsf(v));
+                        dst[i]         += v * post;
+                    }
+                }
+
+                return peak;
+            }
+
+            template <bool RAMP>
+            static float mix_sources_generic(float *dst, const source_t *src, size_t n, float old_post, float post, const float *ramp, size_t count)
+            {
+                const float dp  = post - old_post;
+
+                float peak      = 0.0f;
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float x   = (RAMP) ? ramp[i] : 0.0f;
+                    float v         = 0.0f;
+                    for (size_t j=0; j<n; ++j)
+                    {
+                        const source_t *c = &src[j];
+                        v              += (RAMP) ?
+                            c->vData[i] * (c->fOldGain + (c->fGain - c->fOldGain) * x) :
+                            c->vData[i] * c->fGain;
+                    }
+
+                    peak            = lsp_max(peak, fabsf(v));
+                    dst[i]         += (RAMP) ? v * (old_post + dp * x) : v * post;
+                }
+
+                return peak;
+            }
+
+            template <bool RAMP>
+            static float mix_dispatch(float *dst, const source_t *src, size_t n, float old_post, float post, const float *ramp, size_t count)
+            {
+                if (count <= 0)
+                    return 0.0f;
+
+                switch (n)
+                {
+                    case 0: return 0.0f;
+                    case 1: return mix_sources<1, RAMP>(dst, src, old_post, post, ramp, count);
+                    case 2: return mix_sources<2, RAMP>(dst, src, old_post, post, ramp, count);
+                    case 3: return mix_sources<3, RAMP>(dst, src, old_post, post, ramp, count);
+                    case 4: return mix_sources<4, RAMP>(dst, src, old_post, post, ramp, count);
+                    default:
+                        break;
+                }
+
+                return mix_sources_generic<RAMP>(dst, src, n, old_post, post, ramp, count);
+            }
+
+            // Same as mix_sources() but additionally computes the pre-fader signal and
+            // accumulates the pre-fader or the intermediate signal into the taps
+            template <size_t N, bool RAMP>
+            static float mix_sources_taps(float *dst, const source_t *src, float old_post, float post,
+                                          const tap_t *taps, size_t nt, const float *ramp, size_t count)
+            {
+                const float *s[N];
+                float g[N], dg[N], w[N];
+                float *td[TAPS_MAX];
+                float tg[TAPS_MAX], dt[TAPS_MAX];
+                bool tp[TAPS_MAX];
+
+                for (size_t j=0; j<N; ++j)
+                {
+                    s[j]            = src[j].vData;
+                    g[j]            = (RAMP) ? src[j].fOldGain : src[j].fGain;
+                    dg[j]           = src[j].fGain - src[j].fOldGain;
+                    w[j]            = src[j].fPre;
+                }
+                for (size_t j=0; j<nt; ++j)
+                {
+                    td[j]           = taps[j].vData;
+                    tg[j]           = (RAMP) ? taps[j].fOldGain : taps[j].fGain;
+                    dt[j]           = taps[j].fGain - taps[j].fOldGain;
+                    tp[j]           = taps[j].bPre;
+                }
+
+                const float dp  = post - old_post;
+                const float p0  = (RAMP) ? old_post : post;
+
+                float peak      = 0.0f;
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float x   = (RAMP) ? ramp[i] : 0.0f;
+                    float v         = 0.0f;
+                    float u         = 0.0f;
+                    for (size_t j=0; j<N; ++j)
+                    {
+                        v              += (RAMP) ? s[j][i] * (g[j] + dg[j] * x) : s[j][i] * g[j];
+                        u              += s[j][i] * w[j];
+                    }
+
+                    peak            = lsp_max(peak, fabsf(v));
+                    dst[i]         += (RAMP) ? v * (p0 + dp * x) : v * p0;
+                    for (size_t j=0; j<nt; ++j)
+                        td[j][i]       += ((tp[j]) ? u : v) * ((RAMP) ? tg[j] + dt[j] * x : tg[j]);
+                }
+
+                return peak;
+            }
+
+            template <bool RAMP>
+            static float mix_sources_taps_generic(float *dst, const source_t *src, size_t n, float old_post, float post,
+                                                  const tap_t *taps, size_t nt, const float *ramp, size_t count)
+            {
+                const float dp  = post - old_post;
+
+                float peak      = 0.0f;
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float x   = (RAMP) ? ramp[i] : 0.0f;
+                    float v         = 0.0f;
+                    float u         = 0.0f;
+                    for (size_t j=0; j<n; ++j)
+                    {
+                        const source_t *c = &src[j];
+                        v              += (RAMP) ?
+                            c->vData[i] * (c->fOldGain + (c->fGain - c->fOldGain) * x) :
+                            c->vData[i] * c->fGain;
+                        u              += c->vData[i] * c->fPre;
+                    }
+
+                    peak            = lsp_max(peak, fabsf(v));
+                    dst[i]         += (RAMP) ? v * (old_post + dp * x) : v * post;
+                    for (size_t j=0; j<nt; ++j)
+                    {
+                        const tap_t *t  = &taps[j];
+                        t->vData[i]    += ((t->bPre) ? u : v) *
+                            ((RAMP) ? t->fOldGain + (t->fGain - t->fOldGain) * x : t->fGain);
+                    }
+                }
+
+                return peak;
+            }
+
+            template <bool RAMP>
+            static float mix_taps_dispatch(float *dst, const source_t *src, size_t n, float old_post, float post,
+                                           const tap_t *taps, size_t nt, const float *ramp, size_t count)
+            {
+                switch (n)
+                {
+                    case 1: return mix_sources_taps<1, RAMP>(dst, src, old_post, post, taps, nt, ramp, count);
+                    case 2: return mix_sources_taps<2, RAMP>(dst, src, old_post, post, taps, nt, ramp, count);
+                    case 3: return mix_sources_taps<3, RAMP>(dst, src, old_post, post, taps, nt, ramp, count);
+                    case 4: return mix_sources_taps<4, RAMP>(dst, src, old_post, post, taps, nt, ramp, count);
+                    default:
+                        break;
+                }
+
+                return mix_sources_taps_generic<RAMP>(dst, src, n, old_post, post, taps, nt, ramp, count);
+            }
+
+            // Both outputs of the stereo pair are computed from the same input samples, so
+            // each input buffer is read once. The set of connected returns (bit 0 for the
+            // left return, bit 1 for the right one) is known at compile time, the number
+            // of taps is not, it is usually small
+            template <size_t RET, bool RAMP>
+            static void matrix_taps(float * const *dst, const float * const *src, const matrix_t *m,
+                                    const float *old_post, const float *post, const tap_t *taps, size_t nt,
+                                    const float *ramp, size_t count, float *peak)
+            {
+                float *d0 = dst[0], *d1 = dst[1];
+                float *td[TAPS_MAX][2];
+                float tg[TAPS_MAX][2], dt[TAPS_MAX][2];
+                bool tp[TAPS_MAX];
+
+                const float g00 = (RAMP) ? m->fOldGain[0][0] : m->fGain[0][0];
+                const float g01 = (RAMP) ? m->fOldGain[0][1] : m->fGain[0][1];
+                const float g10 = (RAMP) ? m->fOldGain[1][0] : m->fGain[1][0];
+                const float g11 = (RAMP) ? m->fOldGain[1][1] : m->fGain[1][1];
+                const float d00 = m->fGain[0][0] - m->fOldGain[0][0];
+                const float d01 = m->fGain[0][1] - m->fOldGain[0][1];
+                const float d10 = m->fGain[1][0] - m->fOldGain[1][0];
+                const float d11 = m->fGain[1][1] - m->fOldGain[1][1];
+                const float p0  = (RAMP) ? old_post[0] : post[0];
+                const float p1  = (RAMP) ? old_post[1] : post[1];
+                const float dp0 = post[0] - old_post[0];
+                const float dp1 = post[1] - old_post[1];
+
+                for (size_t k=0; k<nt; ++k)
+                {
+                    for (size_t j=0; j<2; ++j)
+                    {
+                        const tap_t *t  = &taps[k*2 + j];
+                        td[k][j]        = t->vData;
+                        tg[k][j]        = (RAMP) ? t->fOldGain : t->fGain;
+                        dt[k][j]        = t->fGain - t->fOldGain;
+                    }
+                    tp[k]           = taps[k*2].bPre;
+                }
+
+                float peak0     = 0.0f;
+                float peak1     = 0.0f;
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float x   = (RAMP) ? ramp[i] : 0.0f;
+                    float a         = src[0][i];
+                    float b         = src[1][i];
+                    if (RET & 1)
+                        a              += src[2][i];
+                    if (RET & 2)
+                        b              += src[3][i];
+
+                    const float v0  = (RAMP) ? a * (g00 + d00 * x) + b * (g01 + d01 * x) : a * g00 + b * g01;
+                    const float v1  = (RAMP) ? a * (g10 + d10 * x) + b * (g11 + d11 * x) : a * g10 + b * g11;
+
+                    peak0           = lsp_max(peak0, fabsf(v0));
+                    peak1           = lsp_max(peak1, fabsf(v1));
+                    d0[i]          += (RAMP) ? v0 * (p0 + dp0 * x) : v0 * p0;
+                    d1[i]          += (RAMP) ? v1 * (p1 + dp1 * x) : v1 * p1;
+
+                    for (size_t k=0; k<nt; ++k)
+                    {
+                        td[k][0][i]    += ((tp[k]) ? a : v0) * ((RAMP) ? tg[k][0] + dt[k][0] * x : tg[k][0]);
+                        td[k][1][i]    += ((tp[k]) ? b : v1) * ((RAMP) ? tg[k][1] + dt[k][1] * x : tg[k][1]);
+                    }
+                }
+
+                peak[0]         = peak0;
+                peak[1]         = peak1;
+            }
+
+            template <bool RAMP>
+            static void matrix_taps_dispatch(float * const *dst, const float * const *src, const matrix_t *m,
+                                             const float *old_post, const float *post, const tap_t *taps, size_t nt,
+                                             const float *ramp, size_t count, float *peak)
+            {
+                const size_t ret    = ((src[2] != NULL) ? 1 : 0) | ((src[3] != NULL) ? 2 : 0);
+                switch (ret)
+                {
+                    case 0: matrix_taps<0, RAMP>(dst, src, m, old_post, post, taps, nt, ramp, count, peak); break;
+                    case 1: matrix_taps<1, RAMP>(dst, src, m, old_post, post, taps, nt, ramp, count, peak); break;
+                    case 2: matrix_taps<2, RAMP>(dst, src, m, old_post, post, taps, nt, ramp, count, peak); break;
+                    default:
+                        matrix_taps<3, RAMP>(dst, src, m, old_post, post, taps, nt, ramp, count, peak);
+                        break;
+                }
+            }
+
+            // The number of outputs is known at compile time, so all output gains
+            // and deltas stay in registers and the input is read once per sample
+            template <size_t N, bool RAMP>
+            static float spread_outputs(const float *src, float old_gain, float gain, const output_t *dst,
+                                        const float *ramp, size_t count)
+            {
+                float *d[N];
+                float g[N], dg[N];
+
+                for (size_t j=0; j<N; ++j)
+                {
+                    d[j]            = dst[j].vData;
+                    g[j]            = (RAMP) ? dst[j].fOldGain : dst[j].fGain;
+                    dg[j]           = dst[j].fGain - dst[j].fOldGain;
+                }
+
+                float peak      = 0.0f;
+                if (RAMP)
+                {
+                    const float df  = gain - old_gain;
+
+                    for (size_t i=0; i<count; ++i)
+                    {
+                        const float x   = ramp[i];
+                        const float v   = src[i] * (old_gain + df * x);
+                        peak            = lsp_max(peak, fabsf(v));
+                        for (size_t j=0; j<N; ++j)
+                            d[j][i]        += v * (g[j] + dg[j] * x);
+                    }
+                }
+                else
+                {
+                    for (size_t i=0; i<count; ++i)
+                    {
+                        const float v   = src[i] * gain;
+                        peak            = lsp_max(peak, fabsf(v));
+                        for (size_t j=0; j<N; ++j)
+                            d[j][i]        += v * g[j];
+                    }
+                }
+
+                return peak;
+            }
+
+            template <bool RAMP>
+            static float spread_dispatch(const float *src, float old_gain, float gain, const output_t *dst, size_t n,
+                                         const float *ramp, size_t count)
+            {
+                switch (n)
+                {
+                    case 0: return 0.0f;
+                    case 1: return spread_outputs<1, RAMP>(src, old_gain, gain, dst, ramp, count);
+                    case 2: return spread_outputs<2, RAMP>(src, old_gain, gain, dst, ramp, count);
+                    case 3: return spread_outputs<3, RAMP>(src, old_gain, gain, dst, ramp, count);
+                    case 4: return spread_outputs<4, RAMP>(src, old_gain, gain, dst, ramp, count);
+                    case 5: return spread_outputs<5, RAMP>(src, old_gain, gain, dst, ramp, count);
+                    case 6: return spread_outputs<6, RAMP>(src, old_gain, gain, dst, ramp, count);
+                    case 7: return spread_outputs<7, RAMP>(src, old_gain, gain, dst, ramp, count);
+                    default:
+                        break;
+                }
+
+                return spread_outputs<OUTPUTS_MAX, RAMP>(src, old_gain, gain, dst, ramp, count);
+            }
+
+            // Steady state of the bypass crossfade: the output receives either the processed
+            // or the unprocessed signal, the write is omitted if the output already holds it
+            template <bool RET, bool SEND, bool DRY, bool WRITE>
+            static void output_steady(float *out, float *send, const float *in, const float *ret, const float *wet,
+                                      size_t count, float *peak)
+            {
+                float in_peak   = peak[0];
+                float wet_peak  = peak[1];
+
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float x   = (RET) ? in[i] + ret[i] : in[i];
+                    const float w   = wet[i];
+                    const float o   = (DRY) ? x : w;
+                    in_peak         = lsp_max(in_peak, fabsf(x));
+                    wet_peak        = lsp_max(wet_peak, fabsf(w));
+                    if (WRITE)
+                        out[i]          = o;
+                    if (SEND)
+                        send[i]         = o;
+                }
+
+                peak[0]         = in_peak;
+                peak[1]         = wet_peak;
+            }
+
+            template <bool RET, bool SEND>
+            static void output_dispatch(float *out, float *send, const float *in, const float *ret, const float *wet,
+                                        bool dry, size_t count, float *peak)
+            {
+                if (!dry)
+                    output_steady<RET, SEND, false, true>(out, send, in, ret, wet, count, peak);
+                else if ((!RET) && (out == in))
+                    output_steady<RET, SEND, true, false>(out, send, in, ret, wet, count, peak);
+                else
+                    output_steady<RET, SEND, true, true>(out, send, in, ret, wet, count, peak);
+            }
+
+            template <bool RET, bool RAMP>
+            static void dry_wet_loop(float *dst, const float *wet, const float *in, const float *ret,
+                                     const float *old_gain, const float *gain, const float *ramp, size_t count)
+            {
+                const float gw  = old_gain[0], dw = gain[0] - old_gain[0];
+                const float gd  = old_gain[1], dd = gain[1] - old_gain[1];
+                const float gr  = old_gain[2], dr = gain[2] - old_gain[2];
+
+                for (size_t i=0; i<count; ++i)
+                {
+                    float x         = (RAMP) ? wet[i] * (gw + dw * ramp[i]) : wet[i] * gw;
+                    x              += (RAMP) ? in[i] * (gd + dd * ramp[i]) : in[i] * gd;
+                    if (RET)
+                        x              += (RAMP) ? ret[i] * (gr + dr * ramp[i]) : ret[i] * gr;
+                    dst[i]          = x;
+                }
+            }
+
+            static bool matrix_ramping(const matrix_t *m)
+            {
+                return (m->fOldGain[0][0] != m->fGain[0][0]) || (m->fOldGain[0][1] != m->fGain[0][1]) ||
+                       (m->fOldGain[1][0] != m->fGain[1][0]) || (m->fOldGain[1][1] != m->fGain[1][1]);
+            }
+
+            void ramp_shape(float *dst, size_t count)
+            {
+                const float k   = 1.0f / float(count);
+                for (size_t i=0; i<count; ++i)
+                    dst[i]          = float(i) * k;
+            }
+
+            float bus_add(float *dst, const source_t *src, size_t n, float old_post, float post, const float *ramp, size_t count)
+            {
+                bool ramping    = old_post != post;
+                for (size_t i=0; (!ramping) && (i<n); ++i)
+                    ramping         = src[i].fOldGain != src[i].fGain;
+
+                return (ramping) ?
+                    mix_dispatch<true>(dst, src, n, old_post, post, ramp, count) :
+                    mix_dispatch<false>(dst, src, n, post, post, NULL, count);
+            }
+
+            float bus_add_taps(float *dst, const source_t *src, size_t n, float old_post, float post,
+                               const tap_t *taps, size_t nt, const float *ramp, size_t count)
+            {
+                if (nt <= 0)
+                    return bus_add(dst, src, n, old_post, post, ramp, count);
+                if ((count <= 0) || (n <= 0))
+                    return 0.0f;
+
+                nt              = lsp_min(nt, TAPS_MAX);
+                bool ramping    = old_post != post;
+                for (size_t i=0; (!ramping) && (i<n); ++i)
+                    ramping         = src[i].fOldGain != src[i].fGain;
+                for (size_t i=0; (!ramping) && (i<nt); ++i)
+                    ramping         = taps[i].fOldGain != taps[i].fGain;
+
+                return (ramping) ?
+                    mix_taps_dispatch<true>(dst, src, n, old_post, post, taps, nt, ramp, count) :
+                    mix_taps_dispatch<false>(dst, src, n, old_post, post, taps, nt, NULL, count);
+            }
+
+            void copy_gain(float *dst, const float *src, float old_gain, float gain, const float *ramp, size_t count)
+            {
+                if (old_gain == gain)
+                {
+                    dsp::mul_k3(dst, src, gain, count);
+                    return;
+                }
+
+                const float dg  = gain - old_gain;
+                for (size_t i=0; i<count; ++i)
+                    dst[i]          = src[i] * (old_gain + dg * ramp[i]);
+            }
+
+            void dry_wet(float *dst, const float *wet, const float *in, const float *ret,
+                         const float *old_gain, const float *gain, const float *ramp, size_t count)
+            {
+                const bool ramping  = (old_gain[0] != gain[0]) || (old_gain[1] != gain[1]) ||
+                                      ((ret != NULL) && (old_gain[2] != gain[2]));
+
+                if (ret != NULL)
+                {
+                    if (ramping)
+                        dry_wet_loop<true, true>(dst, wet, in, ret, old_gain, gain, ramp, count);
+                    else
+                        dry_wet_loop<true, false>(dst, wet, in, ret, old_gain, gain, NULL, count);
+                }
+                else
+                {
+                    if (ramping)
+                        dry_wet_loop<false, true>(dst, wet, in, NULL, old_gain, gain, ramp, count);
+                    else
+                        dry_wet_loop<false, false>(dst, wet, in, NULL, old_gain, gain, NULL, count);
+                }
+            }
+
+            void matrix_add_taps(float * const *dst, const float * const *src, const matrix_t *m,
+                                 const float *old_post, const float *post, const tap_t *taps, size_t nt,
+                                 const float *ramp, size_t count, float *peak)
+            {
+                peak[0]         = 0.0f;
+                peak[1]         = 0.0f;
+                if (count <= 0)
+                    return;
+
+                nt              = lsp_min(nt, TAPS_MAX);
+                bool ramping    = (matrix_ramping(m)) || (old_post[0] != post[0]) || (old_post[1] != post[1]);
+                for (size_t i=0; (!ramping) && (i<nt*2); ++i)
+                    ramping         = taps[i].fOldGain != taps[i].fGain;
+
+                if (ramping)
+                    matrix_taps_dispatch<true>(dst, src, m, old_post, post, taps, nt, ramp, count, peak);
+                else
+                    matrix_taps_dispatch<false>(dst, src, m, old_post, post, taps, nt, NULL, count, peak);
+            }
+
+            void matrix_apply(float * const *dst, const float * const *src, const matrix_t *m, const float *ramp, size_t count)
+            {
+                float *d0 = dst[0], *d1 = dst[1];
+                const float *s0 = src[0], *s1 = src[1];
+
+                if (!matrix_ramping(m))
+                {
+                    const float g00 = m->fGain[0][0], g01 = m->fGain[0][1];
+                    const float g10 = m->fGain[1][0], g11 = m->fGain[1][1];
+
+                    for (size_t i=0; i<count; ++i)
+                    {
+                        const float a   = s0[i];
+                        const float b   = s1[i];
+                        d0[i]           = a * g00 + b * g01;
+                        d1[i]           = a * g10 + b * g11;
+                    }
+                    return;
+                }
+
+                const float g00 = m->fOldGain[0][0], g01 = m->fOldGain[0][1];
+                const float g10 = m->fOldGain[1][0], g11 = m->fOldGain[1][1];
+                const float d00 = m->fGain[0][0] - g00, d01 = m->fGain[0][1] - g01;
+                const float d10 = m->fGain[1][0] - g10, d11 = m->fGain[1][1] - g11;
+
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float x   = ramp[i];
+                    const float a   = s0[i];
+                    const float b   = s1[i];
+                    d0[i]           = a * (g00 + d00 * x) + b * (g01 + d01 * x);
+                    d1[i]           = a * (g10 + d10 * x) + b * (g11 + d11 * x);
+                }
+            }
+
+            void output_pass(float *out, float *send, const float *in, const float *ret, const float *wet,
+                             xfade_t *xf, size_t count, float *peak)
+            {
+                peak[0]         = 0.0f;
+                peak[1]         = 0.0f;
+
+                // Crossfade until the weight reaches the target
+                size_t i        = 0;
+                float k         = xf->fGain;
+                const float t   = xf->fTarget;
+                if (k != t)
+                {
+                    const float d   = (t > k) ? xf->fDelta : -xf->fDelta;
+                    for ( ; (i < count) && (k != t); ++i)
+                    {
+                        k              += d;
+                        if ((d > 0.0f) ? (k >= t) : (k <= t))
+                            k               = t;
+
+                        const float x   = (ret != NULL) ? in[i] + ret[i] : in[i];
+                        const float w   = wet[i];
+                        const float o   = w + (x - w) * k;
+                        peak[0]         = lsp_max(peak[0], fabsf(x));
+                        peak[1]         = lsp_max(peak[1], fabsf(w));
+                        out[i]          = o;
+                        if (send != NULL)
+                            send[i]         = o;
+                    }
+                    xf->fGain       = k;
+                }
+                if (i >= count)
+                    return;
+
+                // Process the rest of the block in the steady state
+                out            += i;
+                in             += i;
+                wet            += i;
+                count          -= i;
+                const bool dry  = k >= 0.5f;
+                if (send != NULL)
+                {
+                    send           += i;
+                    if (ret != NULL)
+                        output_dispatch<true, true>(out, send, in, ret + i, wet, dry, count, peak);
+                    else
+                        output_dispatch<false, true>(out, send, in, NULL, wet, dry, count, peak);
+                }
+                else
+                {
+                    if (ret != NULL)
+                        output_dispatch<true, false>(out, NULL, in, ret + i, wet, dry, count, peak);
+                    else
+                        output_dispatch<false, false>(out, NULL, in, NULL, wet, dry, count, peak);
+                }
+            }
+
+            void snap_gains(float *dst, float threshold, size_t count)
+            {
+                for (size_t i=0; i<count; ++i)
+                    dst[i]          = (fabsf(dst[i]) < threshold) ? 0.0f : dst[i];
+            }
+
+            float spread_add(const float *src, float old_gain, float gain, const output_t *dst, size_t n,
+                             const float *ramp, size_t count)
+            {
+                if (count <= 0)
+                    return 0.0f;
+
+                // Wider layouts are processed by several passes, each pass yields the same peak
+                float peak      = 0.0f;
+                do
+                {
+                    const size_t nd = lsp_min(n, OUTPUTS_MAX);
+                    bool ramping    = old_gain != gain;
+                    for (size_t i=0; (!ramping) && (i<nd); ++i)
+                        ramping         = dst[i].fOldGain != dst[i].fGain;
+
+                    peak            = (ramping) ?
+                        spread_dispatch<true>(src, old_gain, gain, dst, nd, ramp, count) :
+                        spread_dispatch<false>(src, old_gain, gain, dst, nd, NULL, count);
+
+                    dst            += nd;
+                    n              -= nd;
+                } while (n > 0);
+
+                return peak;
+            }
+
+            void vbap_gains(float *dst, const speaker_t *spk, size_t n, float azimuth, float divergence)
+            {
+                if (n <= 0)
+                    return;
+                for (size_t i=0; i<n; ++i)
+                    dst[spk[i].nChannel]    = 0.0f;
+                if (n == 1)
+                {
+                    dst[spk[0].nChannel]    = 1.0f;
+                    return;
+                }
+
+                // Find the pair of adjacent speakers enclosing the source, the last pair wraps around
+                const float first   = spk[0].fAzimuth;
+                float a             = azimuth;
+                while (a < first)
+                    a                  += 360.0f;
+                while (a >= first + 360.0f)
+                    a                  -= 360.0f;
+
+                size_t k            = n - 1;
+                for (size_t i=0; i<n-1; ++i)
+                    if (a < spk[i + 1].fAzimuth)
+                    {
+                        k                   = i;
+                        break;
+                    }
+                const speaker_t *s1 = &spk[k];
+                const speaker_t *s2 = &spk[(k + 1) % n];
+
+                // Solve p = g1 * l1 + g2 * l2 for unit vectors of the source and speakers
+                const float k_rad   = M_PI / 180.0f;
+                const float px      = sinf(a * k_rad),              py  = cosf(a * k_rad);
+                const float l1x     = sinf(s1->fAzimuth * k_rad),   l1y = cosf(s1->fAzimuth * k_rad);
+                const float l2x     = sinf(s2->fAzimuth * k_rad),   l2y = cosf(s2->fAzimuth * k_rad);
+                const float det     = l1x * l2y - l1y * l2x;
+
+                float g1            = lsp_max((px * l2y - py * l2x) / det, 0.0f);
+                float g2            = lsp_max((py * l1x - px * l1y) / det, 0.0f);
+                const float norm    = sqrtf(g1 * g1 + g2 * g2);
+                if (norm > 0.0f)
+                {
+                    g1                 /= norm;
+                    g2                 /= norm;
+                }
+                dst[s1->nChannel]   = g1;
+                dst[s2->nChannel]   = g2;
+
+                // Spread the power of the source over all speakers
+                if (divergence <= 0.0f)
+                    return;
+                const float d       = lsp_min(divergence, 1.0f);
+                const float share   = d / float(n);
+                for (size_t i=0; i<n; ++i)
+                {
+                    float *g            = &dst[spk[i].nChannel];
+                    *g                  = sqrtf((1.0f - d) * (*g) * (*g) + share);
+                }
+            }
+
+            void pan_gains(float *left, float *right, const float *pan, const float *bal, size_t count)
+            {
+                // Simple element-wise loop without dependencies, gets vectorized by the compiler
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float g   = left[i];
+                    left[i]         = g * ((0.5f - pan[i]) * (1.0f - bal[i]));
+                    right[i]        = g * ((0.5f + pan[i]) * (1.0f + bal[i]));
+                }
+            }
+
+        } /* namespace mix */
+    } /* namespace plugins */
+} /* namespace lsp */
@@ -0,0 +1,553 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <private/plugins/mixer_meters.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        namespace mix
+        {
+            // Duration of the bucket, seconds
+            static constexpr float BUCKET_PERIOD        = 0.01f;
+            // Maximum number of samples processed at once, limits the size of the scratch buffer on the stack
+            static constexpr size_t SEGMENT_SIZE        = 256;
+            // Gain corresponding to the -0.691 dB offset of the loudness formula
+            static constexpr float LOUDNESS_GAIN        = 0.92352786f;
+            // Number of samples the true peak interpolator is skipped or performed for at once
+            static constexpr size_t TP_BLOCK            = 16;
+            // The signal can not clip below -12 dBFS, there the true peak meter shows the sample peak
+            // and the interpolator is performed only if it can exceed the peak already measured
+            static constexpr float TP_THRESHOLD         = 0.25118864f;
+
+            // K-weighting filters of ITU-R BS.1770, the parameters are chosen to match
+            // the coefficients of the recommendation at 48 kHz for any sample rate
+            static constexpr double PRE_FREQ            = 1681.974450955533;
+            static constexpr double PRE_GAIN            = 3.999843853973347;
+            static constexpr double PRE_Q               = 0.7071752369554196;
+            static constexpr double PRE_BAND            = 0.4996667741545416;
+            static constexpr double RLB_FREQ            = 38.13547087602444;
+            static constexpr double RLB_Q               = 0.5003270373238773;
+
+            MeterBank::MeterBank()
+            {
+                vGroups         = NULL;
+                nChannels       = 0;
+                nGroups         = 0;
+                nBucketSize     = 1;
+                nBucketFill     = 0;
+                nPos            = 0;
+                fTpGain         = 1.0f;
+                bTruePeak       = true;
+                sPre.b0         = 1.0f;
+                sPre.b1         = 0.0f;
+                sPre.b2         = 0.0f;
+                sPre.a1         = 0.0f;
+                sPre.a2         = 0.0f;
+                sRlb            = sPre;
+
+                pData           = NULL;
+            }
+
+            MeterBank::~MeterBank()
+            {
+                destroy();
+            }
+
+            status_t MeterBank::init(size_t channels, bool true_peak)
+            {
+                destroy();
+
+                size_t groups           = (channels + LANES - 1) / LANES;
+                size_t szof_groups      = align_size(sizeof(group_t) * groups, DEFAULT_ALIGN);
+                size_t szof_ring        = align_size(sizeof(float) * RING_SIZE * LANES, DEFAULT_ALIGN);
+                size_t alloc            = szof_groups + szof_ring * 3 * groups;
+
+                uint8_t *ptr            = alloc_aligned<uint8_t>(pData, alloc, DEFAULT_ALIGN);
+                if (ptr == NULL)
+                    return STATUS_NO_MEM;
+
+                vGroups                 = reinterpret_cast<group_t *>(ptr);
+                ptr                    += szof_groups;
+                for (size_t i=0; i<groups; ++i)
+                {
+                    group_t *g              = &vGroups[i];
+                    g->vRingK               = reinterpret_cast<float *>(ptr);
+                    ptr                    += szof_ring;
+                    g->vRingR               = reinterpret_cast<float *>(ptr);
+                    ptr                    += szof_ring;
+                    g->vRingP               = reinterpret_cast<float *>(ptr);
+                    ptr                    += szof_ring;
+                    for (size_t j=0; j<LANES; ++j)
+                    {
+                        g->vSrc[j][0]           = NULL;
+                        g->vSrc[j][1]           = NULL;
+                    }
+                }
+
+                nChannels               = channels;
+                nGroups                 = groups;
+                bTruePeak               = true_peak;
+
+                // Design the true peak interpolator: windowed sinc with the cutoff at the
+                // Nyquist frequency of the original signal, split into polyphase components
+                constexpr size_t len    = TP_FACTOR * TP_TAPS;
+                const double center     = (len - 1) * 0.5;
+                for (size_t p=0; p<TP_FACTOR; ++p)
+                {
+                    float *h                = vTpFir[p];
+                    double sum              = 0.0;
+                    for (size_t k=0; k<TP_TAPS; ++k)
+                    {
+                        double t                = (p + k * TP_FACTOR - center) / TP_FACTOR;
+                        double w                = (p + k * TP_FACTOR + 0.5) / len;
+                        double sinc             = (fabs(t) < 1e-9) ? 1.0 : sin(M_PI * t) / (M_PI * t);
+                        double wnd              = 0.42 - 0.5 * cos(2.0 * M_PI * w) + 0.08 * cos(4.0 * M_PI * w);
+                        h[k]                    = sinc * wnd;
+                        sum                    += h[k];
+                    }
+                    // Normalize the gain of each phase
+                    for (size_t k=0; k<TP_TAPS; ++k)
+                        h[k]                    = h[k] / sum;
+                }
+
+                // The interpolated sample can not exceed the peak of its taps by more than the
+                // sum of absolute values of coefficients of the phase
+                fTpGain                 = 1.0f;
+                for (size_t p=0; p<TP_FACTOR; ++p)
+                {
+                    float sum               = 0.0f;
+                    for (size_t k=0; k<TP_TAPS; ++k)
+                        sum                    += fabsf(vTpFir[p][k]);
+                    fTpGain                 = lsp_max(fTpGain, sum);
+                }
+
+                clear();
+
+                return STATUS_OK;
+            }
+
+            void MeterBank::destroy()
+            {
+                free_aligned(pData);
+                vGroups         = NULL;
+                nChannels       = 0;
+                nGroups         = 0;
+            }
+
+            void MeterBank::set_sample_rate(size_t sr)
+            {
+                nBucketSize     = lsp_max(size_t(dspu::seconds_to_samples(sr, BUCKET_PERIOD)), size_t(1));
+
+                // High shelf pre-filter
+                double k        = tan(M_PI * PRE_FREQ / sr);
+                double vh       = pow(10.0, PRE_GAIN / 20.0);
+                double vb       = pow(vh, PRE_BAND);
+                double a0       = 1.0 + k / PRE_Q + k * k;
+                sPre.b0         = (vh + vb * k / PRE_Q + k * k) / a0;
+                sPre.b1         = 2.0 * (k * k - vh) / a0;
+                sPre.b2         = (vh - vb * k / PRE_Q + k * k) / a0;
+                sPre.a1         = 2.0 * (k * k - 1.0) / a0;
+                sPre.a2         = (1.0 - k / PRE_Q + k * k) / a0;
+
+                // RLB high-pass filter
+                k               = tan(M_PI * RLB_FREQ / sr);
+                a0              = 1.0 + k / RLB_Q + k * k;
+                sRlb.b0         = 1.0f;
+                sRlb.b1         = -2.0f;
+                sRlb.b2         = 1.0f;
+                sRlb.a1         = 2.0 * (k * k - 1.0) / a0;
+                sRlb.a2         = (1.0 - k / RLB_Q + k * k) / a0;
+
+                clear();
+            }
+
+            void MeterBank::clear()
+            {
+                for (size_t i=0; i<nGroups; ++i)
+                {
+                    group_t *g      = &vGroups[i];
+                    for (size_t j=0; j<LANES; ++j)
+                    {
+                        g->vPre[0][j]   = 0.0f;
+                        g->vPre[1][j]   = 0.0f;
+                        g->vRlb[0][j]   = 0.0f;
+                        g->vRlb[1][j]   = 0.0f;
+                        g->vK[j]        = 0.0f;
+                        g->vR[j]        = 0.0f;
+                        g->vPeak[j]     = 0.0f;
+                        g->vSumM[j]     = 0.0;
+                        g->vSumS[j]     = 0.0;
+                        g->vSumR[j]     = 0.0;
+                    }
+                    for (size_t j=0; j<TP_TAPS-1; ++j)
+                        for (size_t k=0; k<LANES; ++k)
+                            g->vHist[j][k]  = 0.0f;
+                    for (size_t j=0; j<RING_SIZE * LANES; ++j)
+                    {
+                        g->vRingK[j]    = 0.0f;
+                        g->vRingR[j]    = 0.0f;
+                        g->vRingP[j]    = 0.0f;
+                    }
+                }
+
+                nBucketFill     = 0;
+                nPos            = 0;
+            }
+
+            void MeterBank::bind(size_t channel, const float *a, const float *b)
+            {
+                if (channel >= nChannels)
+                    return;
+
+                group_t *g                  = &vGroups[channel / LANES];
+                const size_t lane           = channel % LANES;
+                g->vSrc[lane][0]            = a;
+                g->vSrc[lane][1]            = (a != NULL) ? b : NULL;
+            }
+
+            void MeterBank::process_segment(group_t *g, size_t offset, size_t count)
+            {
+                constexpr size_t hist       = TP_TAPS - 1;
+                float x[hist + SEGMENT_SIZE][LANES];
+                float (*dst)[LANES]         = &x[hist];
+
+                // Gather the sources into the interleaved buffer after the interpolator history
+                memcpy(x, g->vHist, sizeof(g->vHist));
+                for (size_t l=0; l<LANES; ++l)
+                {
+                    const float *a              = g->vSrc[l][0];
+                    const float *b              = g->vSrc[l][1];
+                    if (a == NULL)
+                    {
+                        for (size_t i=0; i<count; ++i)
+                            dst[i][l]               = 0.0f;
+                    }
+                    else if (b == NULL)
+                    {
+                        a                          += offset;
+                        for (size_t i=0; i<count; ++i)
+                            dst[i][l]               = a[i];
+                    }
+                    else
+                    {
+                        a                          += offset;
+                        b                          += offset;
+                        for (size_t i=0; i<count; ++i)
+                            dst[i][l]               = a[i] + b[i];
+                    }
+                }
+                memcpy(g->vHist, &x[count], sizeof(g->vHist));
+
+                // Keep the state in local lane arrays, the loops over lanes are vectorized
+                const biquad_t pre          = sPre;
+                const biquad_t rlb          = sRlb;
+                float p0[LANES], p1[LANES], r0[LANES], r1[LANES];
+                float ke[LANES], re[LANES], pk[LANES];
+                for (size_t l=0; l<LANES; ++l)
+                {
+                    p0[l]                       = g->vPre[0][l];
+                    p1[l]                       = g->vPre[1][l];
+                    r0[l]                       = g->vRlb[0][l];
+                    r1[l]                       = g->vRlb[1][l];
+                    ke[l]                       = g->vK[l];
+                    re[l]                       = g->vR[l];
+                    pk[l]                       = g->vPeak[l];
+                }
+
+                for (size_t i=0; i<count; ++i)
+                {
+                    const float *s              = dst[i];
+
+                    // K-weighting and energy
+                    for (size_t l=0; l<LANES; ++l)
+                    {
+                        const float v               = s[l];
+                        const float y               = pre.b0 * v + p0[l];
+                        p0[l]                       = pre.b1 * v - pre.a1 * y + p1[l];
+                        p1[l]                       = pre.b2 * v - pre.a2 * y;
+                        const float z               = rlb.b0 * y + r0[l];
+                        r0[l]                       = rlb.b1 * y - rlb.a1 * z + r1[l];
+                        r1[l]                       = rlb.b2 * y - rlb.a2 * z;
+                        ke[l]                      += z * z;
+                        re[l]                      += v * v;
+                    }
+                }
+
+                // The peak meter measures the true peak or the sample peak
+                if (bTruePeak)
+                    measure_true_peak(x, count, pk);
+                else
+                {
+                    for (size_t i=0; i<count; ++i)
+                        for (size_t l=0; l<LANES; ++l)
+                            pk[l]                       = lsp_max(pk[l], fabsf(dst[i][l]));
+                }
+
+                for (size_t l=0; l<LANES; ++l)
+                {
+                    g->vPre[0][l]               = p0[l];
+                    g->vPre[1][l]               = p1[l];
+                    g->vRlb[0][l]               = r0[l];
+                    g->vRlb[1][l]               = r1[l];
+                    g->vK[l]                    = ke[l];
+                    g->vR[l]                    = re[l];
+                    g->vPeak[l]                 = pk[l];
+                }
+            }
+
+            void MeterBank::measure_true_peak(const float (*x)[LANES], size_t count, float *pk) const
+            {
+                constexpr size_t hist       = TP_TAPS - 1;
+                float tp[LANES];
+                for (size_t l=0; l<LANES; ++l)
+                    tp[l]                       = pk[l];
+
+                // True peak includes the sample peak, the interpolator is performed for the block of samples
+                // only if the interpolated samples may exceed both the measured peak and the threshold
+                for (size_t i=0; i<count; i += TP_BLOCK)
+                {
+                    const size_t n              = lsp_min(count - i, TP_BLOCK);
+                    float sp[LANES], wp[LANES];
+                    for (size_t l=0; l<LANES; ++l)
+                    {
+                        sp[l]                       = 0.0f;
+                        wp[l]                       = 0.0f;
+                    }
+                    for (size_t j=0; j<n; ++j)
+                        for (size_t l=0; l<LANES; ++l)
+                            sp[l]                       = lsp_max(sp[l], fabsf(x[hist + i + j][l]));
+                    for (size_t j=0; j<hist; ++j)
+                        for (size_t l=0; l<LANES; ++l)
+                            wp[l]                       = lsp_max(wp[l], fabsf(x[i + j][l]));
+
+                    bool interpolate            = false;
+                    for (size_t l=0; l<LANES; ++l)
+                    {
+                        tp[l]                       = lsp_max(tp[l], sp[l]);
+                        const float bound           = lsp_max(wp[l], sp[l]) * fTpGain;
+                        interpolate                |= bound > lsp_max(tp[l], TP_THRESHOLD);
+                    }
+                    if (!interpolate)
+                        continue;
+
+                    for (size_t j=i; j<i+n; ++j)
+                    {
+                        for (size_t p=0; p<TP_FACTOR; ++p)
+                        {
+                            const float *h              = vTpFir[p];
+                            float acc[LANES];
+                            for (size_t l=0; l<LANES; ++l)
+                                acc[l]                      = 0.0f;
+                            for (size_t k=0; k<TP_TAPS; ++k)
+                            {
+                                const float *t              = x[hist + j - k];
+                                for (size_t l=0; l<LANES; ++l)
+                                    acc[l]                     += h[k] * t[l];
+                            }
+                            for (size_t l=0; l<LANES; ++l)
+                                tp[l]                       = lsp_max(tp[l], fabsf(acc[l]));
+                        }
+                    }
+                }
+
+                for (size_t l=0; l<LANES; ++l)
+                    pk[l]                       = tp[l];
+            }
+
+            void MeterBank::close_bucket(group_t *g, size_t pos)
+            {
+                // The bucket at the current position is the oldest bucket of the short-term window
+                float *rk                   = &g->vRingK[pos * LANES];
+                float *rr                   = &g->vRingR[pos * LANES];
+                float *rp                   = &g->vRingP[pos * LANES];
+                const float *mk             = &g->vRingK[((pos + RING_SIZE - M_BUCKETS) % RING_SIZE) * LANES];
+                const float *mr             = &g->vRingR[((pos + RING_SIZE - RMS_BUCKETS) % RING_SIZE) * LANES];
+
+                for (size_t l=0; l<LANES; ++l)
+                {
+                    g->vSumS[l]                += double(g->vK[l]) - rk[l];
+                    g->vSumM[l]                += double(g->vK[l]) - mk[l];
+                    g->vSumR[l]                += double(g->vR[l]) - mr[l];
+                    rk[l]                       = g->vK[l];
+                    rr[l]                       = g->vR[l];
+                    rp[l]                       = g->vPeak[l];
+                    g->vK[l]                    = 0.0f;
+                    g->vR[l]                    = 0.0f;
+                    g->vPeak[l]                 = 0.0f;
+                }
+            }
+
+            void MeterBank::process(size_t first, size_t n, size_t offset, size_t count)
+            {
+                const size_t last           = lsp_min(first + n, nGroups);
+
+                for (size_t i=first; i<last; ++i)
+                {
+                    group_t *g                  = &vGroups[i];
+                    size_t fill                 = nBucketFill;
+                    size_t pos                  = nPos;
+
+                    for (size_t done=0; done < count; )
+                    {
+                        size_t to_do                = lsp_min(lsp_min(count - done, nBucketSize - fill), SEGMENT_SIZE);
+                        process_segment(g, offset + done, to_do);
+                        done                       += to_do;
+                        fill                       += to_do;
+                        if (fill >= nBucketSize)
+                        {
+                            close_bucket(g, pos);
+                            pos                         = (pos + 1) % RING_SIZE;
+                            fill                        = 0;
+                        }
+                    }
+                }
+            }
+
+            void MeterBank::commit(size_t count)
+            {
+                // Follow the same bucket sequence as process() does for each group
+                nBucketFill                += count;
+                while (nBucketFill >= nBucketSize)
+                {
+                    nBucketFill                -= nBucketSize;
+                    nPos                        = (nPos + 1) % RING_SIZE;
+                }
+            }
+
+            float MeterBank::rms(size_t channel) const
+            {
+                if (channel >= nChannels)
+                    return 0.0f;
+                const group_t *g            = &vGroups[channel / LANES];
+                const double sum            = g->vSumR[channel % LANES];
+                return (sum > 0.0) ? sqrt(sum / (RMS_BUCKETS * nBucketSize)) : 0.0f;
+            }
+
+            float MeterBank::momentary(size_t channel) const
+            {
+                if (channel >= nChannels)
+                    return 0.0f;
+                const group_t *g            = &vGroups[channel / LANES];
+                const double sum            = g->vSumM[channel % LANES];
+                return (sum > 0.0) ? sum / (M_BUCKETS * nBucketSize) : 0.0f;
+            }
+
+            float MeterBank::short_term(size_t channel) const
+            {
+                if (channel >= nChannels)
+                    return 0.0f;
+                const group_t *g            = &vGroups[channel / LANES];
+                const double sum            = g->vSumS[channel % LANES];
+                return (sum > 0.0) ? sum / (S_BUCKETS * nBucketSize) : 0.0f;
+            }
+
+            float MeterBank::true_peak(size_t channel) const
+            {
+                if (channel >= nChannels)
+                    return 0.0f;
+                const group_t *g            = &vGroups[channel / LANES];
+                const size_t lane           = channel % LANES;
+
+                // Current bucket and the completed buckets of the momentary window
+                float peak                  = g->vPeak[lane];
+                for (size_t i=1; i<M_BUCKETS; ++i)
+                {
+                    const size_t pos            = (nPos + RING_SIZE - i) % RING_SIZE;
+                    peak                        = lsp_max(peak, g->vRingP[pos * LANES + lane]);
+                }
+
+                return peak;
+            }
+
+            float MeterBank::loudness(float ms)
+            {
+                return (ms > 0.0f) ? sqrtf(ms) * LOUDNESS_GAIN : 0.0f;
+            }
+
+            void MeterBank::dump(dspu::IStateDumper *v) const
+            {
+                v->begin_array("vGroups", vGroups, nGroups);
+                {
+                    for (size_t i=0; i<nGroups; ++i)
+                    {
+                        const group_t *g    = &vGroups[i];
+
+                        v->begin_object(g, sizeof(group_t));
+                        {
+                            v->writev("vPre0", g->vPre[0], LANES);
+                            v->writev("vPre1", g->vPre[1], LANES);
+                            v->writev("vRlb0", g->vRlb[0], LANES);
+                            v->writev("vRlb1", g->vRlb[1], LANES);
+                            v->writev("vK", g->vK, LANES);
+                            v->writev("vR", g->vR, LANES);
+                            v->writev("vPeak", g->vPeak, LANES);
+                            v->writev("vSumM", g->vSumM, LANES);
+                            v->writev("vSumS", g->vSumS, LANES);
+                            v->writev("vSumR", g->vSumR, LANES);
+                            v->write("vRingK", g->vRingK);
+                            v->write("vRingR", g->vRingR);
+                            v->write("vRingP", g->vRingP);
+                        }
+                        v->end_object();
+                    }
+                }
+                v->end_array();
+
+                v->write("nChannels", nChannels);
+                v->write("nGroups", nGroups);
+                v->write("nBucketSize", nBucketSize);
+                v->write("nBucketFill", nBucketFill);
+                v->write("nPos", nPos);
+                v->begin_object("sPre", &sPre, sizeof(biquad_t));
+                {
+                    v->write("b0", sPre.b0);
+                    v->write("b1", sPre.b1);
+                    v->write("b2", sPre.b2);
+                    v->write("a1", sPre.a1);
+                    v->write("a2", sPre.a2);
+                }
+                v->end_object();
+                v->begin_object("sRlb", &sRlb, sizeof(biquad_t));
+                {
+                    v->write("b0", sRlb.b0);
+                    v->write("b1", sRlb.b1);
+                    v->write("b2", sRlb.b2);
+                    v->write("a1", sRlb.a1);
+                    v->write("a2", sRlb.a2);
+                }
+                v->end_object();
+                v->writev("vTpFir", &vTpFir[0][0], TP_FACTOR * TP_TAPS);
+                v->write("fTpGain", fTpGain);
+                v->write("bTruePeak", bTruePeak);
+                v->write("pData", pData);
+            }
+
+        } /* namespace mix */
+    } /* namespace plugins */
+} /* namespace lsp */
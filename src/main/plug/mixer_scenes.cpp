@@ -0,0 +1,438 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <private/plugins/mixer_scenes.h>
+
+namespace lsp
+{
+    namespace plugins
+    {
+        namespace mix
+        {
+            // The serialized scene is an explicit little-endian layout independent of the ABI:
+            //   header:    magic, version, header size, channels, aux buses, VCAs, subgroups,
+            //              size of the master record, size of the strip record (all uint32);
+            //   master:    dry, wet, output gain, balance (float32), VCA gains, subgroup gains,
+            //              aux bus gains (float32 each), mono output (uint8), subgroup mutes,
+            //              aux pre-fader flags (uint8 each);
+            //   strips:    gain, pan, balance (float32), aux sends (float32 each), VCA and
+            //              subgroup assignments (uint32), solo, mute, phase (uint8).
+            // New fields are appended to records. The reader takes the sizes and the numbers of
+            // buses from the header, skips unknown fields and keeps defaults for missing ones,
+            // so blobs of older and newer versions are accepted.
+            static constexpr uint32_t SCENE_MAGIC   = 0x4e43534d;   // 'MSCN'
+            static constexpr uint32_t SCENE_VERSION = 1;
+            static constexpr size_t HEADER_SIZE     = 9 * sizeof(uint32_t);
+            static constexpr size_t MASTER_SIZE     =
+                4 * sizeof(uint32_t) +
+                (meta::mixer::VCAS + meta::mixer::SUBGROUPS + meta::mixer::AUX_BUSES) * sizeof(uint32_t) +
+                1 + meta::mixer::SUBGROUPS + meta::mixer::AUX_BUSES;
+            static constexpr size_t STRIP_SIZE      =
+                3 * sizeof(uint32_t) +
+                meta::mixer::AUX_BUSES * sizeof(uint32_t) +
+                2 * sizeof(uint32_t) +
+                3;
+
+            typedef struct writer_t
+            {
+                uint8_t            *p;
+            } writer_t;
+
+            typedef struct reader_t
+            {
+                const uint8_t      *p;
+                size_t              left;
+            } reader_t;
+
+            static inline void put_u8(writer_t *w, uint8_t v)
+            {
+                *(w->p++)           = v;
+            }
+
+            static inline void put_u32(writer_t *w, uint32_t v)
+            {
+                w->p[0]             = uint8_t(v);
+                w->p[1]             = uint8_t(v >> 8);
+                w->p[2]             = uint8_t(v >> 16);
+                w->p[3]             = uint8_t(v >> 24);
+                w->p               += sizeof(uint32_t);
+            }
+
+            static inline void put_f32(writer_t *w, float v)
+            {
+                uint32_t u;
+                ::memcpy(&u, &v, sizeof(u));
+                put_u32(w, u);
+            }
+
+            static inline void put_bool(writer_t *w, bool v)
+            {
+                put_u8(w, (v) ? 1 : 0);
+            }
+
+            static inline void init_reader(reader_t *r, const void *data, size_t size)
+            {
+                r->p                = static_cast<const uint8_t *>(data);
+                r->left             = size;
+            }
+
+            static inline bool get_u8(reader_t *r, uint8_t *v)
+            {
+                if (r->left < 1)
+                    return false;
+                *v                  = *(r->p++);
+                --r->left;
+                return true;
+            }
+
+            static inline bool get_u32(reader_t *r, uint32_t *v)
+            {
+                if (r->left < sizeof(uint32_t))
+                    return false;
+                *v                  = uint32_t(r->p[0]) | (uint32_t(r->p[1]) << 8) |
+                                      (uint32_t(r->p[2]) << 16) | (uint32_t(r->p[3]) << 24);
+                r->p               += sizeof(uint32_t);
+                r->left            -= sizeof(uint32_t);
+                return true;
+            }
+
+            static inline bool get_f32(reader_t *r, float *v)
+            {
+                uint32_t u;
+                if (!get_u32(r, &u))
+                    return false;
+                ::memcpy(v, &u, sizeof(u));
+                return true;
+            }
+
+            static inline bool get_bool(reader_t *r, bool *v)
+            {
+                uint8_t u;
+                if (!get_u8(r, &u))
+                    return false;
+                *v                  = u != 0;
+                return true;
+            }
+
+            // Read the array of 'count' serialized values, values that do not fit the destination are skipped
+            template <class T>
+            static inline void get_array(reader_t *r, T *dst, size_t size, size_t count, bool (*get)(reader_t *, T *))
+            {
+                T tmp;
+                for (size_t i=0; i<count; ++i)
+                    get(r, (i < size) ? &dst[i] : &tmp);
+            }
+
+            template <class T>
+            static inline void exchange(T &a, T &b)
+            {
+                T tmp       = a;
+                a           = b;
+                b           = tmp;
+            }
+
+            //-----------------------------------------------------------------
+            void init_settings(strip_settings_t *s)
+            {
+                s->fGain            = GAIN_AMP_0_DB;
+                s->fPan             = 0.0f;
+                s->fBalance         = 0.0f;
+                for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+                    s->vSend[i]         = 0.0f;
+                s->nVca             = 0;
+                s->nGroup           = 0;
+                s->bSolo            = false;
+                s->bMute            = false;
+                s->bPhase           = false;
+            }
+
+            void init_settings(master_settings_t *m)
+            {
+                m->fDry             = GAIN_AMP_0_DB;
+                m->fWet             = GAIN_AMP_0_DB;
+                m->fOutGain         = GAIN_AMP_0_DB;
+                m->fBalance         = 0.0f;
+                for (size_t i=0; i<meta::mixer::VCAS; ++i)
+                    m->vVca[i]          = GAIN_AMP_0_DB;
+                for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+                {
+                    m->vGroupGain[i]    = GAIN_AMP_0_DB;
+                    m->vGroupMute[i]    = false;
+                }
+                for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+                {
+                    m->vAuxGain[i]      = GAIN_AMP_0_DB;
+                    m->vAuxPre[i]       = false;
+                }
+                m->bMonoOut         = false;
+            }
+
+            //-----------------------------------------------------------------
+            SceneBank::SceneBank()
+            {
+                vStrips         = NULL;
+                vMaster         = NULL;
+                vValid          = NULL;
+                vBlob           = NULL;
+                nScenes         = 0;
+                nChannels       = 0;
+
+                pData           = NULL;
+            }
+
+            SceneBank::~SceneBank()
+            {
+                destroy();
+            }
+
+            status_t SceneBank::init(size_t scenes, size_t channels)
+            {
+                destroy();
+
+                const size_t szof_blob  = HEADER_SIZE + MASTER_SIZE + STRIP_SIZE * channels;
+                const size_t szof_strips= align_size(sizeof(strip_settings_t) * scenes * channels, DEFAULT_ALIGN);
+                const size_t szof_master= align_size(sizeof(master_settings_t) * scenes, DEFAULT_ALIGN);
+                const size_t szof_valid = align_size(sizeof(bool) * scenes, DEFAULT_ALIGN);
+                const size_t alloc      = szof_strips + szof_master + szof_valid + align_size(szof_blob, DEFAULT_ALIGN);
+
+                uint8_t *ptr            = alloc_aligned<uint8_t>(pData, alloc, DEFAULT_ALIGN);
+                if (ptr == NULL)
+                    return STATUS_NO_MEM;
+                ::memset(ptr, 0, alloc);
+
+                vStrips                 = advance_ptr_bytes<strip_settings_t>(ptr, szof_strips);
+                vMaster                 = advance_ptr_bytes<master_settings_t>(ptr, szof_master);
+                vValid                  = advance_ptr_bytes<bool>(ptr, szof_valid);
+                vBlob                   = ptr;
+                nScenes                 = scenes;
+                nChannels               = channels;
+
+                return STATUS_OK;
+            }
+
+            void SceneBank::destroy()
+            {
+                free_aligned(pData);
+                vStrips         = NULL;
+                vMaster         = NULL;
+                vValid          = NULL;
+                vBlob           = NULL;
+                nScenes         = 0;
+                nChannels       = 0;
+            }
+
+            void SceneBank::clear()
+            {
+                for (size_t i=0; i<nScenes; ++i)
+                    vValid[i]               = false;
+            }
+
+            void SceneBank::copy(size_t scene, const SceneBank *src)
+            {
+                if ((scene >= lsp_min(nScenes, src->nScenes)) || (nChannels != src->nChannels))
+                    return;
+
+                ::memcpy(strips(scene), &src->vStrips[scene * nChannels], sizeof(strip_settings_t) * nChannels);
+                vMaster[scene]          = src->vMaster[scene];
+                vValid[scene]           = src->vValid[scene];
+            }
+
+            void SceneBank::swap(SceneBank *src)
+            {
+                exchange(vStrips, src->vStrips);
+                exchange(vMaster, src->vMaster);
+                exchange(vValid, src->vValid);
+                exchange(vBlob, src->vBlob);
+                exchange(nScenes, src->nScenes);
+                exchange(nChannels, src->nChannels);
+                exchange(pData, src->pData);
+            }
+
+            size_t SceneBank::blob_size() const
+            {
+                return HEADER_SIZE + MASTER_SIZE + STRIP_SIZE * nChannels;
+            }
+
+            const void *SceneBank::serialize(size_t scene)
+            {
+                writer_t w;
+                w.p                     = vBlob;
+
+                // Header
+                put_u32(&w, SCENE_MAGIC);
+                put_u32(&w, SCENE_VERSION);
+                put_u32(&w, HEADER_SIZE);
+                put_u32(&w, uint32_t(nChannels));
+                put_u32(&w, meta::mixer::AUX_BUSES);
+                put_u32(&w, meta::mixer::VCAS);
+                put_u32(&w, meta::mixer::SUBGROUPS);
+                put_u32(&w, MASTER_SIZE);
+                put_u32(&w, STRIP_SIZE);
+
+                // Master section
+                const master_settings_t *m  = master(scene);
+                put_f32(&w, m->fDry);
+                put_f32(&w, m->fWet);
+                put_f32(&w, m->fOutGain);
+                put_f32(&w, m->fBalance);
+                for (size_t i=0; i<meta::mixer::VCAS; ++i)
+                    put_f32(&w, m->vVca[i]);
+                for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+                    put_f32(&w, m->vGroupGain[i]);
+                for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+                    put_f32(&w, m->vAuxGain[i]);
+                put_bool(&w, m->bMonoOut);
+                for (size_t i=0; i<meta::mixer::SUBGROUPS; ++i)
+                    put_bool(&w, m->vGroupMute[i]);
+                for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+                    put_bool(&w, m->vAuxPre[i]);
+
+                // Mixer channels
+                const strip_settings_t *strip = strips(scene);
+                for (size_t j=0; j<nChannels; ++j)
+                {
+                    const strip_settings_t *s   = &strip[j];
+                    put_f32(&w, s->fGain);
+                    put_f32(&w, s->fPan);
+                    put_f32(&w, s->fBalance);
+                    for (size_t i=0; i<meta::mixer::AUX_BUSES; ++i)
+                        put_f32(&w, s->vSend[i]);
+                    put_u32(&w, s->nVca);
+                    put_u32(&w, s->nGroup);
+                    put_bool(&w, s->bSolo);
+                    put_bool(&w, s->bMute);
+                    put_bool(&w, s->bPhase);
+                }
+
+                return vBlob;
+            }
+
+            bool SceneBank::deserialize(size_t scene, const void *data, size_t size)
+            {
+                // Blobs of other formats and of mixers with another number of channels are ignored
+                reader_t r;
+                uint32_t magic, version, header, channels, aux, vcas, groups, master_size, strip_size;
+                if (data == NULL)
+                    return false;
+                init_reader(&r, data, size);
+                if ((!get_u32(&r, &magic)) || (!get_u32(&r, &version)) || (!get_u32(&r, &header)) ||
+                    (!get_u32(&r, &channels)) || (!get_u32(&r, &aux)) || (!get_u32(&r, &vcas)) ||
+                    (!get_u32(&r, &groups)) || (!get_u32(&r, &master_size)) || (!get_u32(&r, &strip_size)))
+                    return false;
+                if ((magic != SCENE_MAGIC) || (version < 1) || (header < HEADER_SIZE) || (channels != nChannels))
+                    return false;
+                if (uint64_t(size) < uint64_t(header) + master_size + uint64_t(strip_size) * channels)
+                    return false;
+
+                const uint8_t *ptr      = static_cast<const uint8_t *>(data) + header;
+
+                // Master section
+                master_settings_t *m    = master(scene);
+                init_settings(m);
+                init_reader(&r, ptr, master_size);
+                get_f32(&r, &m->fDry);
+                get_f32(&r, &m->fWet);
+                get_f32(&r, &m->fOutGain);
+                get_f32(&r, &m->fBalance);
+                get_array(&r, m->vVca, meta::mixer::VCAS, vcas, get_f32);
+                get_array(&r, m->vGroupGain, meta::mixer::SUBGROUPS, groups, get_f32);
+                get_array(&r, m->vAuxGain, meta::mixer::AUX_BUSES, aux, get_f32);
+                get_bool(&r, &m->bMonoOut);
+                get_array(&r, m->vGroupMute, meta::mixer::SUBGROUPS, groups, get_bool);
+                get_array(&r, m->vAuxPre, meta::mixer::AUX_BUSES, aux, get_bool);
+                ptr                    += master_size;
+
+                // Mixer channels
+                strip_settings_t *strip = strips(scene);
+                for (size_t j=0; j<nChannels; ++j, ptr += strip_size)
+                {
+                    strip_settings_t *s     = &strip[j];
+                    init_settings(s);
+                    init_reader(&r, ptr, strip_size);
+                    get_f32(&r, &s->fGain);
+                    get_f32(&r, &s->fPan);
+                    get_f32(&r, &s->fBalance);
+                    get_array(&r, s->vSend, meta::mixer::AUX_BUSES, aux, get_f32);
+                    get_u32(&r, &s->nVca);
+                    get_u32(&r, &s->nGroup);
+                    get_bool(&r, &s->bSolo);
+                    get_bool(&r, &s->bMute);
+                    get_bool(&r, &s->bPhase);
+                }
+                vValid[scene]           = true;
+
+                return true;
+            }
+
+            void SceneBank::dump(dspu::IStateDumper *v) const
+            {
+                v->write("vStrips", vStrips);
+                v->write("vMaster", vMaster);
+                v->writev("vValid", vValid, nScenes);
+                v->write("vBlob", vBlob);
+                v->write("nScenes", nScenes);
+                v->write("nChannels", nChannels);
+                v->write("pData", pData);
+            }
+
+            void dump_settings(dspu::IStateDumper *v, const char *name, const strip_settings_t *s)
+            {
+                v->begin_object(name, s, sizeof(strip_settings_t));
+                {
+                    v->write("fGain", s->fGain);
+                    v->write("fPan", s->fPan);
+                    v->write("fBalance", s->fBalance);
+                    v->writev("vSend", s->vSend, meta::mixer::AUX_BUSES);
+                    v->write("nVca", s->nVca);
+                    v->write("nGroup", s->nGroup);
+                    v->write("bSolo", s->bSolo);
+                    v->write("bMute", s->bMute);
+                    v->write("bPhase", s->bPhase);
+                }
+                v->end_object();
+            }
+
+            void dump_settings(dspu::IStateDumper *v, const char *name, const master_settings_t *m)
+            {
+                v->begin_object(name, m, sizeof(master_settings_t));
+                {
+                    v->write("fDry", m->fDry);
+                    v->write("fWet", m->fWet);
+                    v->write("fOutGain", m->fOutGain);
+                    v->write("fBalance", m->fBalance);
+                    v->writev("vVca", m->vVca, meta::mixer::VCAS);
+                    v->writev("vGroupGain", m->vGroupGain, meta::mixer::SUBGROUPS);
+                    v->writev("vAuxGain", m->vAuxGain, meta::mixer::AUX_BUSES);
+                    v->write("bMonoOut", m->bMonoOut);
+                    v->writev("vGroupMute", m->vGroupMute, meta::mixer::SUBGROUPS);
+                    v->writev("vAuxPre", m->vAuxPre, meta::mixer::AUX_BUSES);
+                }
+                v->end_object();
+            }
+
+        } /* namespace mix */
+    } /* namespace plugins */
+} /* namespace lsp */
@@ -0,0 +1,595 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/plug-fw/meta/func.h>
+#include <lsp-plug.in/stdlib/math.h>
+
+#include <private/plugins/mixer_surround.h>
+#include <lsp-plug.in/shared/debug.h>
+
+namespace lsp
+{
+    /* The size of the processing tile: the input of one strip and all bus channels fit the data cache */
+    static constexpr size_t SURROUND_TILE_SIZE      = 0x100U;
+    /* Gains below the threshold are replaced by exact zero, so faded-out signals do not decay into subnormals */
+    static constexpr float SURROUND_SNAP_THRESHOLD  = GAIN_AMP_M_120_DB;
+    /* The duration of the bypass crossfade, seconds */
+    static constexpr float SURROUND_BYPASS_TIME     = 0.005f;
+
+    namespace plugins
+    {
+        //---------------------------------------------------------------------
+        // Surround layouts, channels follow the order of the bus: L R C LFE Ls Rs Lb Rb
+        static const mix::speaker_t speakers_5_1[] =
+        {
+            { 4,    -110.0f },  // Ls
+            { 0,    -30.0f  },  // L
+            { 2,    0.0f    },  // C
+            { 1,    30.0f   },  // R
+            { 5,    110.0f  },  // Rs
+        };
+
+        static const mix::speaker_t speakers_7_1[] =
+        {
+            { 6,    -150.0f },  // Lb
+            { 4,    -90.0f  },  // Ls
+            { 0,    -30.0f  },  // L
+            { 2,    0.0f    },  // C
+            { 1,    30.0f   },  // R
+            { 5,    90.0f   },  // Rs
+            { 7,    150.0f  },  // Rb
+        };
+
+        typedef struct layout_t
+        {
+            const mix::speaker_t   *vSpeakers;      // Speakers sorted by azimuth
+            size_t                  nSpeakers;      // Number of speakers
+        } layout_t;
+
+        static const layout_t layouts[] =
+        {
+            { speakers_5_1, sizeof(speakers_5_1) / sizeof(mix::speaker_t) },
+            { speakers_7_1, sizeof(speakers_7_1) / sizeof(mix::speaker_t) },
+        };
+
+        static constexpr size_t LAYOUTS     = sizeof(layouts) / sizeof(layout_t);
+
+        static inline bool is_silent(float old_gain, float gain)
+        {
+            return (old_gain == 0.0f) && (gain == 0.0f);
+        }
+
+        static inline float snap_gain(float gain)
+        {
+            return (fabsf(gain) < SURROUND_SNAP_THRESHOLD) ? 0.0f : gain;
+        }
+
+        //---------------------------------------------------------------------
+        // Implementation
+        mixer_surround::mixer_surround(const meta::plugin_t *meta, size_t strips):
+            Module(meta)
+        {
+            for (size_t i=0; i<CHANNELS; ++i)
+            {
+                bus_channel_t *c    = &vChannels[i];
+
+                c->sBypass.fGain    = 0.0f;
+                c->sBypass.fTarget  = 0.0f;
+                c->sBypass.fDelta   = 1.0f;
+
+                c->vIn              = NULL;
+                c->vOut             = NULL;
+                c->vWet             = NULL;
+                c->fInLevel         = 0.0f;
+                c->fOutLevel        = 0.0f;
+
+                c->pIn              = NULL;
+                c->pOut             = NULL;
+                c->pInLevel         = NULL;
+                c->pOutLevel        = NULL;
+            }
+
+            vStrips         = NULL;
+            nStrips         = strips;
+            nLayout         = LAYOUTS - 1;
+            nTileSize       = SURROUND_TILE_SIZE;
+            fOldDry         = GAIN_AMP_0_DB;
+            fDry            = GAIN_AMP_0_DB;
+            fOldWet         = GAIN_AMP_0_DB;
+            fWet            = GAIN_AMP_0_DB;
+            vRamp[0]        = NULL;
+            vRamp[1]        = NULL;
+            nRampLength     = 0;
+            bRebuild        = false;
+
+            pBypass         = NULL;
+            pLayout         = NULL;
+            pDry            = NULL;
+            pWet            = NULL;
+            pOutGain        = NULL;
+
+            pData           = NULL;
+        }
+
+        mixer_surround::~mixer_surround()
+        {
+            do_destroy();
+        }
+
+        void mixer_surround::init(plug::IWrapper *wrapper, plug::IPort **ports)
+        {
+            // Call parent class for initialization
+            Module::init(wrapper, ports);
+
+            // Estimate the number of bytes to allocate
+            size_t szof_strips      = align_size(sizeof(strip_t) * nStrips, DEFAULT_ALIGN);
+            size_t szof_wet         = align_size(nTileSize * sizeof(float), DEFAULT_ALIGN);
+            size_t szof_ramp        = align_size(nTileSize * sizeof(float), DEFAULT_ALIGN);
+            size_t alloc            = szof_strips + szof_wet * CHANNELS + szof_ramp * 2;
+
+            // Allocate memory-aligned data
+            uint8_t *ptr            = alloc_aligned<uint8_t>(pData, alloc, DEFAULT_ALIGN);
+            if (ptr == NULL)
+                return;
+
+            // Initialize pointers
+            vStrips                 = advance_ptr_bytes<strip_t>(ptr, szof_strips);
+            for (size_t i=0; i<CHANNELS; ++i)
+                vChannels[i].vWet       = advance_ptr_bytes<float>(ptr, szof_wet);
+
+            // The ramp shape of the full tile is built once, the shorter one is built on demand
+            vRamp[0]                = advance_ptr_bytes<float>(ptr, szof_ramp);
+            vRamp[1]                = advance_ptr_bytes<float>(ptr, szof_ramp);
+            mix::ramp_shape(vRamp[0], nTileSize);
+            nRampLength             = 0;
+
+            for (size_t i=0; i<nStrips; ++i)
+            {
+                strip_t *s          = &vStrips[i];
+
+                s->vIn              = NULL;
+                s->fOldGain         = GAIN_AMP_0_DB;
+                s->fGain            = GAIN_AMP_0_DB;
+                for (size_t j=0; j<CHANNELS; ++j)
+                {
+                    s->vOldPan[j]       = GAIN_AMP_M_INF_DB;
+                    s->vPan[j]          = GAIN_AMP_M_INF_DB;
+                    s->vOutputs[j]      = 0;
+                }
+                s->nOutputs         = 0;
+                s->fOutLevel        = 0.0f;
+                s->bSolo            = false;
+
+                s->pIn              = NULL;
+                s->pSolo            = NULL;
+                s->pMute            = NULL;
+                s->pPhase           = NULL;
+                s->pAzimuth         = NULL;
+                s->pDivergence      = NULL;
+                s->pLfe             = NULL;
+                s->pOutGain         = NULL;
+                s->pOutLevel        = NULL;
+            }
+
+            // Bind ports
+            lsp_trace("Binding ports");
+            size_t port_id      = 0;
+
+            // Bind primary inputs and outputs
+            for (size_t i=0; i<CHANNELS; ++i)
+                BIND_PORT(vChannels[i].pIn);
+            for (size_t i=0; i<CHANNELS; ++i)
+                BIND_PORT(vChannels[i].pOut);
+
+            BIND_PORT(pBypass);
+            BIND_PORT(pLayout);
+            BIND_PORT(pDry);
+            BIND_PORT(pWet);
+            BIND_PORT(pOutGain);
+
+            // Bind global level meters
+            for (size_t i=0; i<CHANNELS; ++i)
+                BIND_PORT(vChannels[i].pInLevel);
+            for (size_t i=0; i<CHANNELS; ++i)
+                BIND_PORT(vChannels[i].pOutLevel);
+
+            // Bind ports of strips
+            for (size_t i=0; i<nStrips; ++i)
+            {
+                strip_t *s          = &vStrips[i];
+
+                BIND_PORT(s->pIn);
+                BIND_PORT(s->pSolo);
+                BIND_PORT(s->pMute);
+                BIND_PORT(s->pPhase);
+                BIND_PORT(s->pAzimuth);
+                BIND_PORT(s->pDivergence);
+                BIND_PORT(s->pLfe);
+                BIND_PORT(s->pOutGain);
+                BIND_PORT(s->pOutLevel);
+            }
+        }
+
+        void mixer_surround::destroy()
+        {
+            Module::destroy();
+            do_destroy();
+        }
+
+        void mixer_surround::do_destroy()
+        {
+            vStrips         = NULL;
+            for (size_t i=0; i<CHANNELS; ++i)
+                vChannels[i].vWet   = NULL;
+            vRamp[0]        = NULL;
+            vRamp[1]        = NULL;
+
+            // Free previously allocated data chunk
+            if (pData != NULL)
+            {
+                free_aligned(pData);
+                pData       = NULL;
+            }
+        }
+
+        void mixer_surround::update_sample_rate(long sr)
+        {
+            const float delta   = 1.0f / lsp_max(SURROUND_BYPASS_TIME * sr, 1.0f);
+            for (size_t i=0; i<CHANNELS; ++i)
+                vChannels[i].sBypass.fDelta = delta;
+        }
+
+        void mixer_surround::update_settings()
+        {
+            bool bypass     = pBypass->value() >= 0.5f;
+            for (size_t i=0; i<CHANNELS; ++i)
+                vChannels[i].sBypass.fTarget    = (bypass) ? 1.0f : 0.0f;
+
+            // Update the master bus
+            float out_gain          = pOutGain->value();
+            fOldDry                 = fDry;
+            fDry                    = snap_gain(pDry->value() * out_gain);
+            fOldWet                 = fWet;
+            fWet                    = snap_gain(pWet->value() * out_gain);
+            nLayout                 = lsp_min(size_t(pLayout->value()), LAYOUTS - 1);
+            const layout_t *layout  = &layouts[nLayout];
+
+            // Check soloing option
+            bool has_solo   = false;
+            for (size_t i=0; i<nStrips; ++i)
+            {
+                strip_t *s              = &vStrips[i];
+                s->bSolo                = s->pSolo->value() >= 0.5f;
+                if (s->bSolo)
+                    has_solo                = true;
+            }
+
+            // Compute gains of bus channels, speakers which are not present in the layout get zero gain
+            for (size_t i=0; i<nStrips; ++i)
+            {
+                strip_t *s              = &vStrips[i];
+
+                bool mute               = (s->pMute->value() >= 0.5f) || ((has_solo) && (!s->bSolo));
+                float post_gain         = (mute) ? 0.0f : 1.0f;
+                if (s->pPhase->value() >= 0.5f)
+                    post_gain               = -post_gain;
+
+                float pan[CHANNELS];
+                for (size_t j=0; j<CHANNELS; ++j)
+                    pan[j]                  = 0.0f;
+                mix::vbap_gains(pan, layout->vSpeakers, layout->nSpeakers, s->pAzimuth->value(), s->pDivergence->value() * 0.01f);
+                pan[LFE_CHANNEL]        = s->pLfe->value();
+
+                s->fOldGain             = s->fGain;
+                s->fGain                = snap_gain(s->pOutGain->value());
+                for (size_t j=0; j<CHANNELS; ++j)
+                {
+                    s->vOldPan[j]           = s->vPan[j];
+                    s->vPan[j]              = snap_gain(pan[j]) * post_gain;
+                }
+            }
+
+            build_outputs();
+        }
+
+        void mixer_surround::build_outputs()
+        {
+            bool ramp               = false;
+
+            // Only bus channels the strip contributes to are passed to the kernel, so the cost
+            // of mixing depends on the number of strips and not on the number of bus channels
+            for (size_t i=0; i<nStrips; ++i)
+            {
+                strip_t *s              = &vStrips[i];
+                s->nOutputs             = 0;
+                ramp                    = ramp || (s->fOldGain != s->fGain);
+
+                for (size_t j=0; j<CHANNELS; ++j)
+                {
+                    ramp                    = ramp || (s->vOldPan[j] != s->vPan[j]);
+                    if (!is_silent(s->vOldPan[j], s->vPan[j]))
+                        s->vOutputs[s->nOutputs++]  = j;
+                }
+
+                if (is_silent(s->fOldGain, s->fGain))
+                    s->nOutputs             = 0;
+            }
+
+            // The set of bus channels may change when gain transitions complete
+            bRebuild                = ramp;
+        }
+
+        void mixer_surround::bind_buffers()
+        {
+            for (size_t i=0; i<CHANNELS; ++i)
+            {
+                bus_channel_t *c        = &vChannels[i];
+                c->vIn                  = c->pIn->buffer<float>();
+                c->vOut                 = c->pOut->buffer<float>();
+                c->fInLevel             = 0.0f;
+                c->fOutLevel            = 0.0f;
+            }
+            for (size_t i=0; i<nStrips; ++i)
+            {
+                strip_t *s              = &vStrips[i];
+                s->vIn                  = s->pIn->buffer<float>();
+                s->fOutLevel            = 0.0f;
+            }
+        }
+
+        void mixer_surround::output_meters()
+        {
+            for (size_t i=0; i<CHANNELS; ++i)
+            {
+                bus_channel_t *c        = &vChannels[i];
+                c->pInLevel->set_value(c->fInLevel);
+                c->pOutLevel->set_value(c->fOutLevel);
+            }
+            for (size_t i=0; i<nStrips; ++i)
+            {
+                strip_t *s              = &vStrips[i];
+                s->pOutLevel->set_value(s->fOutLevel);
+            }
+        }
+
+        void mixer_surround::prepare_ramp(size_t count)
+        {
+            // Hosts usually keep the block size, so the shape of the shorter tile is rebuilt rarely
+            if ((count == nTileSize) || (count == nRampLength))
+                return;
+            mix::ramp_shape(vRamp[1], count);
+            nRampLength             = count;
+        }
+
+        inline const float *mixer_surround::ramp(size_t count) const
+        {
+            // Gain transitions complete within the first tile of the block
+            return (count == nTileSize) ? vRamp[0] : vRamp[1];
+        }
+
+        void mixer_surround::mix_strips(size_t count)
+        {
+            mix::output_t out[CHANNELS];
+
+            for (size_t i=0; i<CHANNELS; ++i)
+                dsp::fill_zero(vChannels[i].vWet, count);
+
+            for (size_t i=0; i<nStrips; ++i)
+            {
+                strip_t *s              = &vStrips[i];
+                float level;
+
+                if (s->nOutputs > 0)
+                {
+                    // Mix the strip into all bus channels it contributes to in one pass
+                    for (size_t j=0; j<s->nOutputs; ++j)
+                    {
+                        const size_t k          = s->vOutputs[j];
+                        mix::output_t *o        = &out[j];
+                        o->vData                = vChannels[k].vWet;
+                        o->fOldGain             = s->vOldPan[k];
+                        o->fGain                = s->vPan[k];
+                    }
+                    level                   = mix::spread_add(s->vIn, s->fOldGain, s->fGain, out, s->nOutputs, ramp(count), count);
+                }
+                else
+                {
+                    // Muted or soloed-out strip does not contribute to any bus channel, estimate the level only
+                    float g                 = lsp_max(fabsf(s->fOldGain), fabsf(s->fGain));
+                    level                   = (g > 0.0f) ? g * dsp::abs_max(s->vIn, count) : 0.0f;
+                }
+                s->fOutLevel            = lsp_max(s->fOutLevel, level);
+
+                // Renew old parameters
+                s->fOldGain             = s->fGain;
+                for (size_t j=0; j<CHANNELS; ++j)
+                    s->vOldPan[j]           = s->vPan[j];
+            }
+        }
+
+        void mixer_surround::mix_master(size_t count)
+        {
+            // Mix dry/wet
+            const float old_gain[3] = { fOldWet, fOldDry, 0.0f };
+            const float gain[3]     = { fWet, fDry, 0.0f };
+            for (size_t i=0; i<CHANNELS; ++i)
+            {
+                bus_channel_t *c        = &vChannels[i];
+                mix::dry_wet(c->vWet, c->vWet, c->vIn, NULL, old_gain, gain, ramp(count), count);
+            }
+
+            // Renew old parameters
+            fOldWet                 = fWet;
+            fOldDry                 = fDry;
+        }
+
+        void mixer_surround::output_stage(size_t count)
+        {
+            // Apply bypass and perform metering in one pass
+            for (size_t i=0; i<CHANNELS; ++i)
+            {
+                bus_channel_t *c        = &vChannels[i];
+                float peak[2];
+
+                mix::output_pass(c->vOut, NULL, c->vIn, NULL, c->vWet, &c->sBypass, count, peak);
+
+                c->fInLevel             = lsp_max(c->fInLevel, peak[0]);
+                c->fOutLevel            = lsp_max(c->fOutLevel, peak[1]);
+            }
+        }
+
+        void mixer_surround::advance(size_t count)
+        {
+            for (size_t i=0; i<CHANNELS; ++i)
+            {
+                bus_channel_t *c        = &vChannels[i];
+                c->vIn                 += count;
+                c->vOut                += count;
+            }
+            for (size_t i=0; i<nStrips; ++i)
+                vStrips[i].vIn         += count;
+        }
+
+        void mixer_surround::process(size_t samples)
+        {
+            // Subnormal values of decaying signals are flushed to zero
+            dsp::context_t ctx;
+            dsp::start(&ctx);
+
+            // Obtain audio buffers
+            bind_buffers();
+
+            // Main processing
+            while (samples > 0)
+            {
+                size_t to_process       = lsp_min(samples, nTileSize);
+                prepare_ramp(to_process);
+
+                mix_strips(to_process);
+                mix_master(to_process);
+                output_stage(to_process);
+
+                // Update pointers
+                advance(to_process);
+                samples                -= to_process;
+            }
+
+            // Output level meters
+            output_meters();
+
+            // Drop bus channels that became silent after the end of gain transition
+            if (bRebuild)
+                build_outputs();
+
+            dsp::finish(&ctx);
+        }
+
+        void mixer_surround::dump(dspu::IStateDumper *v) const
+        {
+            v->begin_array("vChannels", vChannels, CHANNELS);
+            for (size_t i=0; i<CHANNELS; ++i)
+            {
+                const bus_channel_t *c = &vChannels[i];
+                v->begin_object(c, sizeof(bus_channel_t));
+                {
+                    v->begin_object("sBypass", &c->sBypass, sizeof(mix::xfade_t));
+                    {
+                        v->write("fGain", c->sBypass.fGain);
+                        v->write("fTarget", c->sBypass.fTarget);
+                        v->write("fDelta", c->sBypass.fDelta);
+                    }
+                    v->end_object();
+                    v->write("vIn", c->vIn);
+                    v->write("vOut", c->vOut);
+                    v->write("vWet", c->vWet);
+                    v->write("fInLevel", c->fInLevel);
+                    v->write("fOutLevel", c->fOutLevel);
+
+                    v->write("pIn", c->pIn);
+                    v->write("pOut", c->pOut);
+                    v->write("pInLevel", c->pInLevel);
+                    v->write("pOutLevel", c->pOutLevel);
+                }
+                v->end_object();
+            }
+            v->end_array();
+
+            v->begin_array("vStrips", vStrips, nStrips);
+            for (size_t i=0; i<nStrips; ++i)
+            {
+                const strip_t *s = &vStrips[i];
+                v->begin_object(s, sizeof(strip_t));
+                {
+                    v->write("vIn", s->vIn);
+                    v->write("fOldGain", s->fOldGain);
+                    v->write("fGain", s->fGain);
+                    v->writev("vOldPan", s->vOldPan, CHANNELS);
+                    v->writev("vPan", s->vPan, CHANNELS);
+                    v->writev("vOutputs", s->vOutputs, s->nOutputs);
+                    v->write("nOutputs", s->nOutputs);
+                    v->write("fOutLevel", s->fOutLevel);
+                    v->write("bSolo", s->bSolo);
+
+                    v->write("pIn", s->pIn);
+                    v->write("pSolo", s->pSolo);
+                    v->write("pMute", s->pMute);
+                    v->write("pPhase", s->pPhase);
+                    v->write("pAzimuth", s->pAzimuth);
+                    v->write("pDivergence", s->pDivergence);
+                    v->write("pLfe", s->pLfe);
+                    v->write("pOutGain", s->pOutGain);
+                    v->write("pOutLevel", s->pOutLevel);
+                }
+                v->end_object();
+            }
+            v->end_array();
+
+            v->write("nStrips", nStrips);
+            v->write("nLayout", nLayout);
+            v->write("nTileSize", nTileSize);
+            v->write("fOldDry", fOldDry);
+            v->write("fDry", fDry);
+            v->write("fOldWet", fOldWet);
+            v->write("fWet", fWet);
+            v->begin_array("vRamp", vRamp, 2);
+            {
+                v->write(vRamp[0]);
+                v->write(vRamp[1]);
+            }
+            v->end_array();
+            v->write("nRampLength", nRampLength);
+            v->write("bRebuild", bRebuild);
+
+            v->write("pBypass", pBypass);
+            v->write("pLayout", pLayout);
+            v->write("pDry", pDry);
+            v->write("pWet", pWet);
+            v->write("pOutGain", pOutGain);
+
+            v->write("pData", pData);
+        }
+
+    } /* namespace plugins */
+} /* namespace lsp */
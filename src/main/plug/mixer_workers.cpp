@@ -0,0 +1,410 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/common/debug.h>
+#include <lsp-plug.in/dsp/dsp.h>
+
+#include <private/plugins/mixer_workers.h>
+
+#if defined(PLATFORM_WINDOWS)
+    #include <windows.h>
+#elif defined(PLATFORM_MACOSX)
+    #include <dispatch/dispatch.h>
+    #include <pthread.h>
+    #include <sched.h>
+#else
+    #include <errno.h>
+    #include <pthread.h>
+    #include <sched.h>
+#endif /* PLATFORM_WINDOWS */
+
+namespace lsp
+{
+    namespace plugins
+    {
+        namespace mix
+        {
+            // The ticket packs the batch serial number, the number of jobs and the index
+            // of the next job into one word, so a worker can not take a job of the batch
+            // it has not observed
+            static constexpr uatomic_t TICKET_NEXT_MASK     = 0xffU;
+            static constexpr uatomic_t TICKET_JOBS_SHIFT    = 8;
+            static constexpr uatomic_t TICKET_SERIAL_SHIFT  = 16;
+
+            // The number of polls a worker performs after the batch before going to sleep. Each poll
+            // is followed by the CPU pause, so the window lasts for tens of microseconds and covers
+            // back-to-back batches of one block only
+            static constexpr size_t WORKER_SPIN_POLLS       = 0x800U;
+            // The number of polls the calling thread performs while waiting for jobs taken by
+            // workers before it goes to sleep until the last of them completes
+            static constexpr size_t WAIT_SPIN_POLLS         = 0x400U;
+
+            static inline size_t ticket_serial(uatomic_t ticket)
+            {
+                return ticket >> TICKET_SERIAL_SHIFT;
+            }
+
+            static inline void cpu_pause()
+            {
+            #if defined(ARCH_X86)
+                __builtin_ia32_pause();
+            #elif defined(ARCH_ARM) || defined(ARCH_AARCH64)
+                __asm__ __volatile__ ("yield");
+            #endif /* ARCH_X86 */
+            }
+
+            //-----------------------------------------------------------------
+            WorkerPool::Wakeup::Wakeup()
+            {
+            #if defined(PLATFORM_WINDOWS)
+                hSem        = CreateSemaphoreW(NULL, 0, LONG_MAX, NULL);
+                bValid      = hSem != NULL;
+            #elif defined(PLATFORM_MACOSX)
+                hSem        = dispatch_semaphore_create(0);
+                bValid      = hSem != NULL;
+            #else
+                bValid      = sem_init(&hSem, 0, 0) == 0;
+            #endif /* PLATFORM_WINDOWS */
+            }
+
+            WorkerPool::Wakeup::~Wakeup()
+            {
+                if (!bValid)
+                    return;
+
+            #if defined(PLATFORM_WINDOWS)
+                CloseHandle(hSem);
+            #elif defined(PLATFORM_MACOSX)
+                dispatch_release(static_cast<dispatch_semaphore_t>(hSem));
+            #else
+                sem_destroy(&hSem);
+            #endif /* PLATFORM_WINDOWS */
+                bValid      = false;
+            }
+
+            void WorkerPool::Wakeup::post()
+            {
+            #if defined(PLATFORM_WINDOWS)
+                ReleaseSemaphore(hSem, 1, NULL);
+            #elif defined(PLATFORM_MACOSX)
+                dispatch_semaphore_signal(static_cast<dispatch_semaphore_t>(hSem));
+            #else
+                sem_post(&hSem);
+            #endif /* PLATFORM_WINDOWS */
+            }
+
+            void WorkerPool::Wakeup::wait()
+            {
+            #if defined(PLATFORM_WINDOWS)
+                WaitForSingleObject(hSem, INFINITE);
+            #elif defined(PLATFORM_MACOSX)
+                dispatch_semaphore_wait(static_cast<dispatch_semaphore_t>(hSem), DISPATCH_TIME_FOREVER);
+            #else
+                while ((sem_wait(&hSem) != 0) && (errno == EINTR))
+                    /* restart */;
+            #endif /* PLATFORM_WINDOWS */
+            }
+
+            //-----------------------------------------------------------------
+            WorkerPool::Worker::Worker(WorkerPool *pool, size_t index)
+            {
+                pPool       = pool;
+                nIndex      = index;
+                nSleep      = 0;
+            }
+
+            WorkerPool::Worker::~Worker()
+            {
+                pPool       = NULL;
+            }
+
+            status_t WorkerPool::Worker::run()
+            {
+                size_t serial   = ticket_serial(atomic_load(&pPool->nTicket));
+                uatomic_t prio  = 0;
+
+                // Jobs are processed with subnormals flushed to zero like the processing thread does
+                dsp::context_t ctx;
+                dsp::start(&ctx);
+
+                while (atomic_load(&pPool->nExit) == 0)
+                {
+                    // Spin for a short time waiting for the next batch
+                    if (nIndex < atomic_load(&pPool->nActive))
+                    {
+                        size_t s        = serial;
+                        for (size_t polls=0; polls < WORKER_SPIN_POLLS; ++polls)
+                        {
+                            s               = ticket_serial(atomic_load(&pPool->nTicket));
+                            if (s != serial)
+                                break;
+                            cpu_pause();
+                        }
+
+                        // Take part in the batch processing with the priority of the host processing thread
+                        if (s != serial)
+                        {
+                            serial          = s;
+                            const uatomic_t p   = atomic_load(&pPool->nPrioSerial);
+                            if (p != prio)
+                            {
+                                prio            = p;
+                                pPool->apply_priority();
+                            }
+                            pPool->execute(nIndex + 1);
+                            continue;
+                        }
+                    }
+
+                    // Announce the sleep and check the state again, the batch may have been
+                    // published before the announcement became visible to the calling thread
+                    atomic_store(&nSleep, uatomic_t(1));
+                    const bool wake = (atomic_load(&pPool->nExit) != 0) ||
+                        ((nIndex < atomic_load(&pPool->nActive)) && (ticket_serial(atomic_load(&pPool->nTicket)) != serial));
+                    if ((wake) && (atomic_cas(&nSleep, uatomic_t(1), uatomic_t(0))))
+                        continue;
+
+                    // Sleep until the calling thread wakes the worker up
+                    sWakeup.wait();
+                }
+
+                dsp::finish(&ctx);
+
+                return STATUS_OK;
+            }
+
+            //-----------------------------------------------------------------
+            WorkerPool::WorkerPool()
+            {
+                for (size_t i=0; i<WORKERS_MAX; ++i)
+                    vWorkers[i]     = NULL;
+                nWorkers        = 0;
+                pFunc           = NULL;
+                pArg            = NULL;
+                nSerial         = 0;
+                nPolicy         = 0;
+                nPriority       = 0;
+                bPriority       = false;
+                nWaiting        = 0;
+                nPrioSerial     = 0;
+                nTicket         = 0;
+                nDone           = 0;
+                nActive         = 0;
+                nExit           = 0;
+            }
+
+            WorkerPool::~WorkerPool()
+            {
+                destroy();
+            }
+
+            status_t WorkerPool::init(job_func_t func, void *arg, size_t workers)
+            {
+                destroy();
+
+                pFunc           = func;
+                pArg            = arg;
+                nSerial         = 0;
+                bPriority       = false;
+                atomic_store(&nTicket, uatomic_t(0));
+                atomic_store(&nDone, uatomic_t(0));
+                atomic_store(&nActive, uatomic_t(0));
+                atomic_store(&nExit, uatomic_t(0));
+                atomic_store(&nWaiting, uatomic_t(0));
+                atomic_store(&nPrioSerial, uatomic_t(0));
+
+                // Without the wake-up event the calling thread could not wait for workers
+                if (!sDone.valid())
+                    return STATUS_UNKNOWN_ERR;
+
+                workers         = lsp_min(workers, WORKERS_MAX);
+                while (nWorkers < workers)
+                {
+                    Worker *w       = new Worker(this, nWorkers);
+                    if (w == NULL)
+                        return STATUS_NO_MEM;
+                    if (!w->sWakeup.valid())
+                    {
+                        delete w;
+                        return STATUS_UNKNOWN_ERR;
+                    }
+
+                    status_t res    = w->start();
+                    if (res != STATUS_OK)
+                    {
+                        delete w;
+                        return res;
+                    }
+                    vWorkers[nWorkers++]    = w;
+                }
+
+                return STATUS_OK;
+            }
+
+            void WorkerPool::destroy()
+            {
+                if (nWorkers <= 0)
+                    return;
+
+                atomic_store(&nExit, uatomic_t(1));
+                for (size_t i=0; i<nWorkers; ++i)
+                    vWorkers[i]->sWakeup.post();
+
+                for (size_t i=0; i<nWorkers; ++i)
+                {
+                    Worker *w       = vWorkers[i];
+                    w->join();
+                    delete w;
+                    vWorkers[i]     = NULL;
+                }
+
+                nWorkers        = 0;
+                atomic_store(&nActive, uatomic_t(0));
+                atomic_store(&nExit, uatomic_t(0));
+            }
+
+            void WorkerPool::capture_priority()
+            {
+            #if defined(PLATFORM_WINDOWS)
+                nPolicy         = 0;
+                nPriority       = GetThreadPriority(GetCurrentThread());
+            #else
+                struct sched_param param;
+                int policy      = SCHED_OTHER;
+                if (pthread_getschedparam(pthread_self(), &policy, &param) == 0)
+                {
+                    nPolicy         = policy;
+                    nPriority       = param.sched_priority;
+                }
+                else
+                {
+                    nPolicy         = SCHED_OTHER;
+                    nPriority       = 0;
+                }
+            #endif /* PLATFORM_WINDOWS */
+            }
+
+            void WorkerPool::apply_priority()
+            {
+            #if defined(PLATFORM_WINDOWS)
+                if (nPriority <= THREAD_PRIORITY_NORMAL)
+                    return;
+                if (!SetThreadPriority(GetCurrentThread(), nPriority))
+                    lsp_warn("Could not set priority of mixer worker thread, error=%d", int(GetLastError()));
+            #else
+                if (nPolicy == SCHED_OTHER)
+                    return;
+                struct sched_param param;
+                param.sched_priority    = nPriority;
+                const int res   = pthread_setschedparam(pthread_self(), nPolicy, &param);
+                if (res != 0)
+                    lsp_warn("Could not set real-time priority of mixer worker thread, error=%d", res);
+            #endif /* PLATFORM_WINDOWS */
+            }
+
+            void WorkerPool::set_active(size_t workers)
+            {
+                atomic_store(&nActive, uatomic_t(lsp_min(workers, nWorkers)));
+            }
+
+            void WorkerPool::execute(size_t worker)
+            {
+                while (true)
+                {
+                    const uatomic_t ticket  = atomic_load(&nTicket);
+                    const size_t next       = ticket & TICKET_NEXT_MASK;
+                    const size_t jobs       = (ticket >> TICKET_JOBS_SHIFT) & TICKET_NEXT_MASK;
+                    if (next >= jobs)
+                        break;
+                    if (!atomic_cas(&nTicket, ticket, ticket + 1))
+                        continue;
+
+                    pFunc(pArg, next, worker);
+                    atomic_add(&nDone, uatomic_t(1));
+
+                    // The worker that completes the last job wakes up the sleeping calling thread
+                    if ((worker > 0) && (atomic_load(&nDone) >= jobs) && (atomic_cas(&nWaiting, uatomic_t(1), uatomic_t(0))))
+                        sDone.post();
+                }
+            }
+
+            void WorkerPool::wait(size_t jobs)
+            {
+                // Spin for a short time, jobs taken by workers usually complete together with ours
+                for (size_t polls=0; polls < WAIT_SPIN_POLLS; ++polls)
+                {
+                    if (atomic_load(&nDone) >= jobs)
+                        return;
+                    cpu_pause();
+                }
+
+                while (true)
+                {
+                    // Announce the sleep and check the state again, the last job may have completed
+                    // before the announcement became visible to workers
+                    atomic_store(&nWaiting, uatomic_t(1));
+                    if ((atomic_load(&nDone) >= jobs) && (atomic_cas(&nWaiting, uatomic_t(1), uatomic_t(0))))
+                        return;
+
+                    // Sleep until the worker that completes the last job wakes us up. The worker that
+                    // completed the previous batch may wake us up too early, so the state is checked again
+                    sDone.wait();
+                    if (atomic_load(&nDone) >= jobs)
+                        return;
+                }
+            }
+
+            void WorkerPool::run(size_t jobs)
+            {
+                jobs            = lsp_min(jobs, JOBS_MAX);
+
+                // Workers take the scheduling priority of the processing thread that runs the first batch
+                if (!bPriority)
+                {
+                    capture_priority();
+                    bPriority       = true;
+                    atomic_add(&nPrioSerial, uatomic_t(1));
+                }
+
+                // Publish the batch
+                nSerial         = (nSerial + 1) & 0xffff;
+                atomic_store(&nDone, uatomic_t(0));
+                atomic_store(&nTicket, uatomic_t((nSerial << TICKET_SERIAL_SHIFT) | (jobs << TICKET_JOBS_SHIFT)));
+
+                // Wake up the sleeping workers, the worker that cancels its sleep sees the batch on its own
+                const size_t active = lsp_min(size_t(atomic_load(&nActive)), lsp_min(jobs, nWorkers));
+                for (size_t i=0; i<active; ++i)
+                {
+                    Worker *w       = vWorkers[i];
+                    if (atomic_cas(&w->nSleep, uatomic_t(1), uatomic_t(0)))
+                        w->sWakeup.post();
+                }
+
+                // Take part in processing and wait until all jobs taken by workers complete
+                execute(0);
+                if (atomic_load(&nDone) < jobs)
+                    wait(jobs);
+            }
+
+        } /* namespace mix */
+    } /* namespace plugins */
+} /* namespace lsp */
@@ -22,7 +22,7 @@
 #include <lsp-plug.in/common/debug.h>
 #include <lsp-plug.in/plug-fw/ui.h>
 #include <lsp-plug.in/stdlib/stdio.h>
-#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
 
 #include <private/plugins/mixer.h>
 #include <private/ui/mixer.h>
@@ -39,9 +39,16 @@ namespace lsp
             &meta::mixer_x4_mono,
             &meta::mixer_x8_mono,
             &meta::mixer_x16_mono,
+            &meta::mixer_x32_mono,
+            &meta::mixer_x64_mono,
             &meta::mixer_x4_stereo,
             &meta::mixer_x8_stereo,
-            &meta::mixer_x16_stereo
+            &meta::mixer_x16_stereo,
+            &meta::mixer_x32_stereo,
+            &meta::mixer_x64_stereo,
+            &meta::mixer_x8_surround,
+            &meta::mixer_x16_surround,
+            &meta::mixer_x32_surround
         };
 
         static ui::Module *ui_factory(const meta::plugin_t *meta)
@@ -49,7 +56,7 @@ namespace lsp
             return new mixer(meta);
         }
 
-        static ui::Factory factory(ui_factory, plugin_uis, 6);
+        static ui::Factory factory(ui_factory, plugin_uis, 13);
 
 
         //---------------------------------------------------------------------
@@ -61,6 +68,8 @@ namespace lsp
 
         mixer::~mixer()
         {
+            vChanged.flush();
+            vChannels.flush();
         }
 
         status_t mixer::post_init()
@@ -81,6 +90,7 @@ namespace lsp
                 if (c == NULL)
                     return STATUS_NO_MEM;
 
+                c->pUI          = this;
                 c->nIndex       = i+1;
                 c->bNameChanged = false;
 
@@ -90,9 +100,15 @@ namespace lsp
                 {
                     c->wName->text()->set("lists.mixer.channel");
                     c->wName->text()->params()->set_int("id", int(c->nIndex));
+                }
+            }
 
+            // Bind slots when the list is complete, adding channels may relocate the list
+            for (size_t i=0, n=vChannels.size(); i<n; ++i)
+            {
+                channel_t *c = vChannels.uget(i);
+                if (c->wName != NULL)
                     c->wName->slots()->bind(tk::SLOT_CHANGE, slot_channel_name_updated, c);
-                }
             }
 
             return STATUS_OK;
@@ -117,15 +133,25 @@ namespace lsp
         {
         }
 
+        void mixer::mark_name_changed(channel_t *c)
+        {
+            if ((c->wName == NULL) || (c->bNameChanged))
+                return;
+            if (vChanged.add(c))
+                c->bNameChanged = true;
+        }
+
         void mixer::sync_channel_names(core::KVTStorage *kvt)
         {
             LSPString value;
 
-            for (size_t i=0, n=vChannels.size(); i<n; ++i)
+            // Submit all queued names, names received from KVT in the meantime are skipped
+            for (size_t i=0, n=vChanged.size(); i<n; ++i)
             {
-                channel_t *c = vChannels.uget(i);
-                if ((c->wName == NULL) || (!c->bNameChanged))
+                channel_t *c = vChanged.uget(i);
+                if (!c->bNameChanged)
                     continue;
+                c->bNameChanged = false;
 
                 // Obtain the new instrument name
                 if (c->wName->text()->format(&value) != STATUS_OK)
@@ -134,6 +160,8 @@ namespace lsp
                 // Submit new value to KVT
                 set_channel_name(kvt, c->nIndex, value.get_utf8());
             }
+
+            vChanged.clear();
         }
 
         void mixer::set_channel_name(core::KVTStorage *kvt, int id, const char *name)
@@ -152,53 +180,56 @@ namespace lsp
 
         void mixer::idle()
         {
-            // Scan the list of instrument names for changes
-            size_t changes = 0;
-            for (size_t i=0, n=vChannels.size(); i<n; ++i)
+            // Apply changed instrument names to KVT
+            if (vChanged.is_empty())
+                return;
+
+            core::KVTStorage *kvt = wrapper()->kvt_lock();
+            if (kvt != NULL)
             {
-                channel_t *c = vChannels.uget(i);
-                if ((c->wName != NULL) && (c->bNameChanged))
-                    ++changes;
+                sync_channel_names(kvt);
+                wrapper()->kvt_release();
             }
+        }
+
+        mixer::channel_t *mixer::kvt_channel(const char *id)
+        {
+            static const char prefix[]  = "/channel/";
+            static const char suffix[]  = "/name";
 
-            // Apply instrument names to KVT
-            if (changes > 0)
+            if (::strncmp(id, prefix, sizeof(prefix) - 1) != 0)
+                return NULL;
+            id         += sizeof(prefix) - 1;
+
+            // Parse the channel number, channels are numbered in the order of the list
+            size_t index = 0;
+            const char *p = id;
+            for ( ; (*p >= '0') && (*p <= '9'); ++p)
             {
-                core::KVTStorage *kvt = wrapper()->kvt_lock();
-                if (kvt != NULL)
-                {
-                    sync_channel_names(kvt);
-                    wrapper()->kvt_release();
-                }
+                index       = index * 10 + size_t(*p - '0');
+                if (index > vChannels.size())
+                    return NULL;
             }
+            if ((p == id) || (index <= 0) || (::strcmp(p, suffix) != 0))
+                return NULL;
+
+            channel_t *c = vChannels.uget(index - 1);
+            return (c->wName != NULL) ? c : NULL;
         }
 
         void mixer::kvt_changed(core::KVTStorage *kvt, const char *id, const core::kvt_param_t *value)
         {
             ui::Module::kvt_changed(kvt, id, value);
 
-            if ((value->type == core::KVT_STRING) && (::strstr(id, "/channel/") == id))
-            {
-                id += ::strlen("/channel/");
+            if (value->type != core::KVT_STRING)
+                return;
 
-                char *endptr = NULL;
-                errno = 0;
-                long index = ::strtol(id, &endptr, 10);
+            channel_t *c = kvt_channel(id);
+            if (c == NULL)
+                return;
 
-                // Valid object number?
-                if ((errno == 0) && (!::strcmp(endptr, "/name")) && (index > 0))
-                {
-                    for (size_t i=0, n=vChannels.size(); i<n; ++i)
-                    {
-                        channel_t *c = vChannels.uget(i);
-                        if ((c->wName == NULL) || (c->nIndex != size_t(index)))
-                            continue;
-
-                        c->wName->text()->set_raw(value->str);
-                        c->bNameChanged = false;
-                    }
-                }
-            }
+            c->wName->text()->set_raw(value->str);
+            c->bNameChanged = false;
         }
 
         status_t mixer::reset_settings()
@@ -215,7 +246,7 @@ namespace lsp
 
                     c->wName->text()->set("lists.mixer.channel");
                     c->wName->text()->params()->set_int("id", int(c->nIndex));
-                    c->bNameChanged  = true;
+                    mark_name_changed(c);
                 }
 
                 sync_channel_names(kvt);
@@ -228,7 +259,7 @@ namespace lsp
         status_t mixer::slot_channel_name_updated(tk::Widget *sender, void *ptr, void *data)
         {
             channel_t *c    = static_cast<channel_t *>(ptr);
-            c->bNameChanged = true;
+            c->pUI->mark_name_changed(c);
 
             return STATUS_OK;
         }
@@ -0,0 +1,1101 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/mtest.h>
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/dsp-units/units.h>
+#include <lsp-plug.in/plug-fw/plug.h>
+#include <lsp-plug.in/plug-fw/meta/func.h>
+#include <lsp-plug.in/runtime/system.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/stdlib.h>
+#include <lsp-plug.in/stdlib/string.h>
+
+#include <private/meta/mixer.h>
+
+#ifdef PLATFORM_WINDOWS
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif /* PLATFORM_WINDOWS */
+
+/*
+ * Offline renderer of the mixer session.
+ *
+ * Usage: mixer.render <session-file>
+ *
+ * The session file consists of 'key = value' lines, '#' starts the comment:
+ *
+ *   plugin = mixer_x8_stereo       # UID of the mixer plugin, required
+ *   sample_rate = 48000            # Sample rate, taken from the first WAV file by default
+ *   block = 8192                   # Processing block size
+ *   raw_channels = 2               # Number of channels in RAW (32-bit float LE) files
+ *   master = master.wav            # Output file for the master bus
+ *   stem_3 = vocals.wav            # Output file for the stem of strip 3
+ *   in_1 = drums.wav               # Stereo strip input: file channels 1 and 2
+ *   in_2l = bass.raw@2             # Mono input or single channel of stereo strip: file channel 2
+ *   cg_1 = -6 db                   # Any control port: value in port units or decibels
+ *   cp_2l = -50
+ *   cm_4 = on
+ *
+ * Input files are memory-mapped and streamed block by block. A stem is the
+ * result of the session rendered with the single strip soloed, so it reflects
+ * the routing, subgroup and VCA settings of that strip. The master and all stems
+ * are rendered in one pass: each output has its own plugin instance, and all
+ * instances process the same input buffers that are read once per block. All
+ * outputs are written as 32-bit floating-point WAV files.
+ */
+
+namespace lsp
+{
+    namespace
+    {
+        static constexpr size_t ENTRIES_MAX     = 4096;
+        static constexpr size_t SOURCES_MAX     = 256;
+        static constexpr size_t OUTPUTS_MAX     = 256;
+        static constexpr size_t LINE_LENGTH_MAX        = 4096;
+        static constexpr size_t BLOCK_DFL       = 8192;
+        static constexpr size_t BLOCK_MIN       = 16;
+        static constexpr size_t BLOCK_MAX       = 65536;
+        static constexpr size_t WAV_HEADER_SIZE = 44;
+
+        enum sample_format_t
+        {
+            SF_U8,
+            SF_S16,
+            SF_S24,
+            SF_S32,
+            SF_F32,
+            SF_F64
+        };
+
+        typedef struct entry_t
+        {
+            char               *sKey;           // Parameter name
+            char               *sValue;         // Parameter value
+            size_t              nLine;          // Line number in the session file
+        } entry_t;
+
+        typedef struct source_t
+        {
+            char               *sPath;          // Path to the file
+            const uint8_t      *pFile;          // Mapped file contents
+            size_t              nFileSize;      // Size of the mapped file
+            const uint8_t      *pData;          // Audio samples
+            size_t              nFrames;        // Number of frames
+            size_t              nChannels;      // Number of channels
+            size_t              nSampleRate;    // Sample rate, 0 if not known
+            size_t              nSampleSize;    // Size of one sample in bytes
+            sample_format_t     enFormat;       // Sample format
+        #ifdef PLATFORM_WINDOWS
+            HANDLE              hFile;
+            HANDLE              hMapping;
+        #else
+            int                 hFd;
+        #endif /* PLATFORM_WINDOWS */
+        } source_t;
+
+        typedef struct binding_t
+        {
+            size_t              nPort;          // Index of the input port
+            source_t           *pSource;        // Source file
+            size_t              nChannel;       // Channel of the source file
+        } binding_t;
+
+        typedef struct param_t
+        {
+            size_t              nPort;          // Index of the control port
+            float               fValue;         // Value of the port
+        } param_t;
+
+        class RenderPort;
+        class RenderWrapper;
+
+        typedef struct output_t
+        {
+            const char         *sPath;          // Path to the output file
+            const char         *sSolo;          // Solo switch of the stem strip, NULL for the master output
+            RenderPort        **vPorts;         // Ports of the plugin instance
+            plug::Module       *pModule;        // Plugin instance
+            RenderWrapper      *pWrapper;       // Wrapper of the plugin instance
+            float              *vOuts[meta::mixer::SURROUND_CHANNELS];  // Outputs of the master bus
+            size_t              nOuts;          // Number of outputs of the master bus
+            FILE               *pFd;            // Output file
+        } output_t;
+
+        typedef struct session_t
+        {
+            entry_t             vEntries[ENTRIES_MAX];
+            source_t           *vSources[SOURCES_MAX];
+            binding_t           vBindings[ENTRIES_MAX * 2];
+            param_t             vParams[ENTRIES_MAX];
+            output_t            vOutputs[OUTPUTS_MAX];
+            char                vSolo[OUTPUTS_MAX][64];
+            size_t              nEntries;
+            size_t              nSources;
+            size_t              nBindings;
+            size_t              nParams;
+            size_t              nOutputs;
+
+            plug::Factory      *pFactory;
+            const meta::plugin_t *pMeta;
+            size_t              nSampleRate;
+            size_t              nBlock;
+            size_t              nRawChannels;
+            size_t              nFrames;
+        } session_t;
+
+        /**
+         * In-memory port
+         */
+        class RenderPort: public plug::IPort
+        {
+            private:
+                float          *vBuffer;
+                float           fValue;
+                uint8_t        *pData;
+
+            public:
+                explicit RenderPort(const meta::port_t *meta): IPort(meta)
+                {
+                    vBuffer     = NULL;
+                    fValue      = meta->start;
+                    pData       = NULL;
+                }
+
+                virtual ~RenderPort() override
+                {
+                    free_aligned(pData);
+                }
+
+            public:
+                bool init(size_t block, float *shared)
+                {
+                    if (!meta::is_audio_port(pMetadata))
+                        return true;
+
+                    // Inputs of all plugin instances share the buffers filled once per block
+                    if (shared != NULL)
+                    {
+                        vBuffer     = shared;
+                        return true;
+                    }
+
+                    vBuffer     = alloc_aligned<float>(pData, block, DEFAULT_ALIGN);
+                    if (vBuffer == NULL)
+                        return false;
+                    dsp::fill_zero(vBuffer, block);
+
+                    return true;
+                }
+
+                inline float *data()            { return vBuffer; }
+
+                // Wrappers expose the bypass port to the host as the inverted 'enabled' switch
+                virtual float value() override  { return (pMetadata->role == meta::R_BYPASS) ? 1.0f - fValue : fValue; }
+                virtual void set_value(float value) override { fValue = value; }
+                virtual void *buffer() override { return vBuffer; }
+        };
+
+        /**
+         * Wrapper that provides no services to the plugin
+         */
+        class RenderWrapper: public plug::IWrapper
+        {
+            public:
+                explicit RenderWrapper(plug::Module *plugin): IWrapper(plugin, NULL) {}
+        };
+
+        //---------------------------------------------------------------------
+        // Byte-level helpers, independent of the CPU byte order
+        static inline uint32_t get_le16(const uint8_t *p)
+        {
+            return uint32_t(p[0]) | (uint32_t(p[1]) << 8);
+        }
+
+        static inline uint32_t get_le32(const uint8_t *p)
+        {
+            return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+        }
+
+        static inline uint64_t get_le64(const uint8_t *p)
+        {
+            return uint64_t(get_le32(p)) | (uint64_t(get_le32(&p[4])) << 32);
+        }
+
+        static inline void put_le16(uint8_t *p, uint32_t v)
+        {
+            p[0]    = uint8_t(v);
+            p[1]    = uint8_t(v >> 8);
+        }
+
+        static inline void put_le32(uint8_t *p, uint32_t v)
+        {
+            p[0]    = uint8_t(v);
+            p[1]    = uint8_t(v >> 8);
+            p[2]    = uint8_t(v >> 16);
+            p[3]    = uint8_t(v >> 24);
+        }
+
+        static char *trim(char *s)
+        {
+            while ((*s == ' ') || (*s == '\t'))
+                ++s;
+            char *e = &s[strlen(s)];
+            while ((e > s) && ((e[-1] == ' ') || (e[-1] == '\t') || (e[-1] == '\r') || (e[-1] == '\n')))
+                --e;
+            *e = '\0';
+            return s;
+        }
+
+        //---------------------------------------------------------------------
+        // Memory-mapped sources
+        static bool map_source(source_t *s)
+        {
+        #ifdef PLATFORM_WINDOWS
+            s->hFile        = CreateFileA(s->sPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+            if (s->hFile == INVALID_HANDLE_VALUE)
+                return false;
+            LARGE_INTEGER size;
+            if ((!GetFileSizeEx(s->hFile, &size)) || (size.QuadPart <= 0))
+                return false;
+            s->nFileSize    = size.QuadPart;
+            s->hMapping     = CreateFileMappingA(s->hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+            if (s->hMapping == NULL)
+                return false;
+            s->pFile        = static_cast<const uint8_t *>(MapViewOfFile(s->hMapping, FILE_MAP_READ, 0, 0, 0));
+            return s->pFile != NULL;
+        #else
+            s->hFd          = open(s->sPath, O_RDONLY);
+            if (s->hFd < 0)
+                return false;
+            struct stat st;
+            if ((fstat(s->hFd, &st) != 0) || (st.st_size <= 0))
+                return false;
+            s->nFileSize    = st.st_size;
+            void *addr      = mmap(NULL, s->nFileSize, PROT_READ, MAP_SHARED, s->hFd, 0);
+            if (addr == MAP_FAILED)
+                return false;
+            s->pFile        = static_cast<const uint8_t *>(addr);
+            madvise(addr, s->nFileSize, MADV_SEQUENTIAL);
+            return true;
+        #endif /* PLATFORM_WINDOWS */
+        }
+
+        static void destroy_source(source_t *s)
+        {
+            if (s == NULL)
+                return;
+
+        #ifdef PLATFORM_WINDOWS
+            if (s->pFile != NULL)
+                UnmapViewOfFile(s->pFile);
+            if (s->hMapping != NULL)
+                CloseHandle(s->hMapping);
+            if (s->hFile != INVALID_HANDLE_VALUE)
+                CloseHandle(s->hFile);
+        #else
+            if (s->pFile != NULL)
+                munmap(const_cast<uint8_t *>(s->pFile), s->nFileSize);
+            if (s->hFd >= 0)
+                close(s->hFd);
+        #endif /* PLATFORM_WINDOWS */
+
+            free(s->sPath);
+            delete s;
+        }
+
+        static bool parse_wav(source_t *s)
+        {
+            const uint8_t *p    = s->pFile;
+            const uint8_t *end  = &p[s->nFileSize];
+            if ((s->nFileSize < 12) || (memcmp(p, "RIFF", 4)) || (memcmp(&p[8], "WAVE", 4)))
+                return false;
+
+            size_t format = 0, bits = 0;
+            bool fmt_found = false;
+            for (p += 12; (end - p) >= 8; )
+            {
+                const size_t size   = get_le32(&p[4]);
+                const uint8_t *body = &p[8];
+                const size_t avail  = lsp_min(size, size_t(end - body));
+
+                if ((!memcmp(p, "fmt ", 4)) && (avail >= 16))
+                {
+                    format              = get_le16(body);
+                    s->nChannels        = get_le16(&body[2]);
+                    s->nSampleRate      = get_le32(&body[4]);
+                    bits                = get_le16(&body[14]);
+                    // WAVE_FORMAT_EXTENSIBLE: the format is stored in the sub-format GUID
+                    if ((format == 0xfffe) && (avail >= 26))
+                        format              = get_le16(&body[24]);
+                    fmt_found           = true;
+                }
+                else if ((!memcmp(p, "data", 4)) && (fmt_found))
+                {
+                    if (format == 1)
+                    {
+                        switch (bits)
+                        {
+                            case 8:  s->enFormat = SF_U8;  break;
+                            case 16: s->enFormat = SF_S16; break;
+                            case 24: s->enFormat = SF_S24; break;
+                            case 32: s->enFormat = SF_S32; break;
+                            default: return false;
+                        }
+                    }
+                    else if (format == 3)
+                    {
+                        switch (bits)
+                        {
+                            case 32: s->enFormat = SF_F32; break;
+                            case 64: s->enFormat = SF_F64; break;
+                            default: return false;
+                        }
+                    }
+                    else
+                        return false;
+
+                    if (s->nChannels <= 0)
+                        return false;
+                    s->nSampleSize      = bits / 8;
+                    s->pData            = body;
+                    s->nFrames          = avail / (s->nChannels * s->nSampleSize);
+                    return true;
+                }
+
+                p                   = &body[size + (size & 1)];
+            }
+
+            return false;
+        }
+
+        static source_t *open_source(const char *path, size_t raw_channels)
+        {
+            source_t *s     = new source_t;
+            if (s == NULL)
+                return NULL;
+
+            s->sPath        = strdup(path);
+            s->pFile        = NULL;
+            s->nFileSize    = 0;
+            s->pData        = NULL;
+            s->nFrames      = 0;
+            s->nChannels    = 0;
+            s->nSampleRate  = 0;
+            s->nSampleSize  = 0;
+            s->enFormat     = SF_F32;
+        #ifdef PLATFORM_WINDOWS
+            s->hFile        = INVALID_HANDLE_VALUE;
+            s->hMapping     = NULL;
+        #else
+            s->hFd          = -1;
+        #endif /* PLATFORM_WINDOWS */
+
+            if ((s->sPath == NULL) || (!map_source(s)))
+            {
+                printf("Could not map file '%s'\n", path);
+                destroy_source(s);
+                return NULL;
+            }
+
+            const size_t len = strlen(path);
+            if ((len >= 4) && ((!strcmp(&path[len-4], ".wav")) || (!strcmp(&path[len-4], ".WAV"))))
+            {
+                if (!parse_wav(s))
+                {
+                    printf("Unsupported or damaged WAV file '%s'\n", path);
+                    destroy_source(s);
+                    return NULL;
+                }
+            }
+            else
+            {
+                // RAW file: interleaved 32-bit little-endian floating-point samples
+                s->pData        = s->pFile;
+                s->nChannels    = raw_channels;
+                s->nSampleSize  = sizeof(float);
+                s->nFrames      = s->nFileSize / (s->nChannels * s->nSampleSize);
+            }
+
+            return s;
+        }
+
+        /**
+         * Convert samples of the source channel to floating-point
+         */
+        static void read_source(float *dst, const source_t *s, size_t channel, size_t offset, size_t count)
+        {
+            const size_t avail  = (offset < s->nFrames) ? lsp_min(count, s->nFrames - offset) : 0;
+            const size_t stride = s->nChannels * s->nSampleSize;
+            const uint8_t *p    = &s->pData[offset * stride + channel * s->nSampleSize];
+
+            switch (s->enFormat)
+            {
+                case SF_U8:
+                    for (size_t i=0; i<avail; ++i, p += stride)
+                        dst[i]      = (float(p[0]) - 128.0f) * (1.0f / 128.0f);
+                    break;
+                case SF_S16:
+                    for (size_t i=0; i<avail; ++i, p += stride)
+                        dst[i]      = float(int16_t(get_le16(p))) * (1.0f / 0x8000);
+                    break;
+                case SF_S24:
+                    for (size_t i=0; i<avail; ++i, p += stride)
+                    {
+                        const uint32_t v = (uint32_t(p[0]) << 8) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 24);
+                        dst[i]      = float(int32_t(v)) * (1.0f / 0x80000000U);
+                    }
+                    break;
+                case SF_S32:
+                    for (size_t i=0; i<avail; ++i, p += stride)
+                        dst[i]      = float(int32_t(get_le32(p))) * (1.0f / 0x80000000U);
+                    break;
+                case SF_F32:
+                    for (size_t i=0; i<avail; ++i, p += stride)
+                    {
+                        const uint32_t v = get_le32(p);
+                        memcpy(&dst[i], &v, sizeof(float));
+                    }
+                    break;
+                case SF_F64:
+                    for (size_t i=0; i<avail; ++i, p += stride)
+                    {
+                        const uint64_t v = get_le64(p);
+                        double d;
+                        memcpy(&d, &v, sizeof(double));
+                        dst[i]      = d;
+                    }
+                    break;
+            }
+
+            if (avail < count)
+                dsp::fill_zero(&dst[avail], count - avail);
+        }
+
+        //---------------------------------------------------------------------
+        // WAV output
+        static bool write_wav_header(FILE *fd, size_t channels, size_t sample_rate, size_t frames)
+        {
+            uint8_t hdr[WAV_HEADER_SIZE];
+            const uint64_t data_size = uint64_t(frames) * channels * sizeof(float);
+            const uint32_t size = uint32_t(lsp_min(data_size, uint64_t(0xffffffffU - WAV_HEADER_SIZE)));
+
+            memcpy(&hdr[0], "RIFF", 4);
+            put_le32(&hdr[4], size + WAV_HEADER_SIZE - 8);
+            memcpy(&hdr[8], "WAVE", 4);
+            memcpy(&hdr[12], "fmt ", 4);
+            put_le32(&hdr[16], 16);
+            put_le16(&hdr[20], 3);                                      // WAVE_FORMAT_IEEE_FLOAT
+            put_le16(&hdr[22], channels);
+            put_le32(&hdr[24], sample_rate);
+            put_le32(&hdr[28], sample_rate * channels * sizeof(float)); // Byte rate
+            put_le16(&hdr[32], channels * sizeof(float));               // Block align
+            put_le16(&hdr[34], 32);                                     // Bits per sample
+            memcpy(&hdr[36], "data", 4);
+            put_le32(&hdr[40], size);
+
+            return (fseek(fd, 0, SEEK_SET) == 0) && (fwrite(hdr, sizeof(hdr), 1, fd) == 1);
+        }
+
+        static bool write_wav_frames(FILE *fd, float * const *bufs, size_t channels, size_t count, uint8_t *tmp)
+        {
+            uint8_t *p = tmp;
+            for (size_t i=0; i<count; ++i)
+                for (size_t j=0; j<channels; ++j, p += sizeof(float))
+                {
+                    uint32_t v;
+                    memcpy(&v, &bufs[j][i], sizeof(float));
+                    put_le32(p, v);
+                }
+
+            return fwrite(tmp, channels * sizeof(float), count, fd) == count;
+        }
+
+        //---------------------------------------------------------------------
+        // Session
+        static void destroy_session(session_t *s)
+        {
+            for (size_t i=0; i<s->nEntries; ++i)
+            {
+                free(s->vEntries[i].sKey);
+                free(s->vEntries[i].sValue);
+            }
+            for (size_t i=0; i<s->nSources; ++i)
+                destroy_source(s->vSources[i]);
+
+            s->nEntries     = 0;
+            s->nSources     = 0;
+        }
+
+        static bool load_session(session_t *s, const char *path)
+        {
+            FILE *fd = fopen(path, "r");
+            if (fd == NULL)
+            {
+                printf("Could not open session file '%s'\n", path);
+                return false;
+            }
+
+            char line[LINE_LENGTH_MAX];
+            bool res = true;
+            for (size_t n=1; fgets(line, sizeof(line), fd) != NULL; ++n)
+            {
+                char *comment = strchr(line, '#');
+                if (comment != NULL)
+                    *comment = '\0';
+                char *key = trim(line);
+                if (*key == '\0')
+                    continue;
+
+                char *eq = strchr(key, '=');
+                if (eq == NULL)
+                {
+                    printf("%s:%d: expected 'key = value'\n", path, int(n));
+                    res = false;
+                    break;
+                }
+                if (s->nEntries >= ENTRIES_MAX)
+                {
+                    printf("%s:%d: too many entries\n", path, int(n));
+                    res = false;
+                    break;
+                }
+
+                *eq = '\0';
+                entry_t *e  = &s->vEntries[s->nEntries++];
+                e->sKey     = strdup(trim(key));
+                e->sValue   = strdup(trim(&eq[1]));
+                e->nLine    = n;
+                if ((e->sKey == NULL) || (e->sValue == NULL))
+                {
+                    res = false;
+                    break;
+                }
+            }
+
+            fclose(fd);
+            return res;
+        }
+
+        static const char *find_entry(const session_t *s, const char *key)
+        {
+            const char *res = NULL;
+            for (size_t i=0; i<s->nEntries; ++i)
+                if (!strcmp(s->vEntries[i].sKey, key))
+                    res = s->vEntries[i].sValue;
+            return res;
+        }
+
+        static ssize_t find_port(const meta::plugin_t *meta, const char *id)
+        {
+            for (size_t i=0; meta->ports[i].id != NULL; ++i)
+                if (!strcmp(meta->ports[i].id, id))
+                    return i;
+            return -1;
+        }
+
+        static bool is_global_key(const char *key)
+        {
+            return (!strcmp(key, "plugin")) ||
+                (!strcmp(key, "sample_rate")) ||
+                (!strcmp(key, "block")) ||
+                (!strcmp(key, "raw_channels")) ||
+                (!strcmp(key, "master")) ||
+                (!strncmp(key, "stem_", 5));
+        }
+
+        static bool parse_value(const char *text, float *value)
+        {
+            if ((!strcmp(text, "on")) || (!strcmp(text, "true")))
+            {
+                *value  = 1.0f;
+                return true;
+            }
+            if ((!strcmp(text, "off")) || (!strcmp(text, "false")))
+            {
+                *value  = 0.0f;
+                return true;
+            }
+
+            char *end = NULL;
+            float v = strtof(text, &end);
+            if (end == text)
+                return false;
+            while (*end == ' ')
+                ++end;
+            if ((!strcmp(end, "db")) || (!strcmp(end, "dB")))
+                v = dspu::db_to_gain(v);
+            else if (*end != '\0')
+                return false;
+
+            *value  = v;
+            return true;
+        }
+
+        static source_t *find_source(session_t *s, const char *path)
+        {
+            for (size_t i=0; i<s->nSources; ++i)
+                if (!strcmp(s->vSources[i]->sPath, path))
+                    return s->vSources[i];
+
+            if (s->nSources >= SOURCES_MAX)
+                return NULL;
+            source_t *src = open_source(path, s->nRawChannels);
+            if (src != NULL)
+                s->vSources[s->nSources++] = src;
+            return src;
+        }
+
+        static bool bind_input(session_t *s, const entry_t *e, ssize_t port, size_t channels)
+        {
+            // Parse 'path[@channel]', the channel number is 1-based
+            char path[LINE_LENGTH_MAX];
+            strncpy(path, e->sValue, sizeof(path) - 1);
+            path[sizeof(path) - 1] = '\0';
+
+            size_t channel  = 0;
+            char *at        = strrchr(path, '@');
+            if (at != NULL)
+            {
+                *at             = '\0';
+                channel         = atoi(&at[1]);
+                if (channel <= 0)
+                {
+                    printf("line %d: bad channel number for input '%s'\n", int(e->nLine), e->sKey);
+                    return false;
+                }
+                --channel;
+            }
+
+            source_t *src   = find_source(s, trim(path));
+            if (src == NULL)
+                return false;
+            if (channel + channels > src->nChannels)
+            {
+                printf("line %d: file '%s' has no channel %d\n", int(e->nLine), src->sPath, int(channel + channels));
+                return false;
+            }
+            if (src->nSampleRate != 0)
+            {
+                if (s->nSampleRate == 0)
+                    s->nSampleRate  = src->nSampleRate;
+                else if (src->nSampleRate != s->nSampleRate)
+                {
+                    printf("line %d: sample rate of '%s' does not match the session sample rate\n", int(e->nLine), src->sPath);
+                    return false;
+                }
+            }
+
+            // Stereo strip inputs are bound to the pair of adjacent channels
+            for (size_t i=0; i<channels; ++i)
+            {
+                binding_t *b    = &s->vBindings[s->nBindings++];
+                b->nPort        = port + i;
+                b->pSource      = src;
+                b->nChannel     = channel + i;
+            }
+            s->nFrames      = lsp_max(s->nFrames, src->nFrames);
+
+            return true;
+        }
+
+        static bool configure_session(session_t *s)
+        {
+            const meta::plugin_t *meta = s->pMeta;
+            const char *v;
+
+            s->nSampleRate  = ((v = find_entry(s, "sample_rate")) != NULL) ? atoi(v) : 0;
+            s->nBlock       = ((v = find_entry(s, "block")) != NULL) ? atoi(v) : BLOCK_DFL;
+            s->nBlock       = lsp_limit(s->nBlock, BLOCK_MIN, BLOCK_MAX);
+            s->nRawChannels = ((v = find_entry(s, "raw_channels")) != NULL) ? atoi(v) : 1;
+            s->nRawChannels = lsp_max(s->nRawChannels, size_t(1));
+
+            for (size_t i=0; i<s->nEntries; ++i)
+            {
+                const entry_t *e    = &s->vEntries[i];
+                if (is_global_key(e->sKey))
+                    continue;
+
+                ssize_t port        = find_port(meta, e->sKey);
+                if (port < 0)
+                {
+                    // Stereo strip input specified by the strip name
+                    char id[64];
+                    snprintf(id, sizeof(id), "%sl", e->sKey);
+                    port                = find_port(meta, id);
+                    snprintf(id, sizeof(id), "%sr", e->sKey);
+                    const ssize_t right = find_port(meta, id);
+                    if ((port >= 0) && (right == port + 1) && (meta::is_audio_in_port(&meta->ports[port])))
+                    {
+                        if (!bind_input(s, e, port, 2))
+                            return false;
+                        continue;
+                    }
+
+                    printf("line %d: unknown parameter '%s'\n", int(e->nLine), e->sKey);
+                    return false;
+                }
+
+                const meta::port_t *p = &meta->ports[port];
+                if (meta::is_audio_in_port(p))
+                {
+                    if (!bind_input(s, e, port, 1))
+                        return false;
+                }
+                else if ((meta::is_control_port(p)) || (p->role == meta::R_BYPASS))
+                {
+                    param_t *param      = &s->vParams[s->nParams++];
+                    param->nPort        = port;
+                    if (!parse_value(e->sValue, &param->fValue))
+                    {
+                        printf("line %d: bad value '%s' for parameter '%s'\n", int(e->nLine), e->sValue, e->sKey);
+                        return false;
+                    }
+                }
+                else
+                {
+                    printf("line %d: parameter '%s' can not be set\n", int(e->nLine), e->sKey);
+                    return false;
+                }
+            }
+
+            if (s->nSampleRate == 0)
+                s->nSampleRate  = 48000;
+
+            return true;
+        }
+
+        //---------------------------------------------------------------------
+        // Rendering
+        static bool open_output(session_t *s, output_t *o, float * const *inputs, size_t n_ports)
+        {
+            const meta::plugin_t *meta = s->pMeta;
+
+            o->vPorts       = new RenderPort *[n_ports];
+            if (o->vPorts == NULL)
+                return false;
+            for (size_t i=0; i<n_ports; ++i)
+                o->vPorts[i]    = NULL;
+
+            // Create ports and find outputs of the master bus
+            for (size_t i=0; i<n_ports; ++i)
+            {
+                const meta::port_t *p = &meta->ports[i];
+                if (((o->vPorts[i] = new RenderPort(p)) == NULL) || (!o->vPorts[i]->init(s->nBlock, inputs[i])))
+                    return false;
+                if ((meta::is_audio_out_port(p)) && ((!strcmp(p->id, "out")) || (!strncmp(p->id, "out_", 4))) && (o->nOuts < meta::mixer::SURROUND_CHANNELS))
+                    o->vOuts[o->nOuts++]    = o->vPorts[i]->data();
+            }
+            if (o->nOuts <= 0)
+                return false;
+
+            // Create the plugin and apply the session
+            if ((o->pModule = s->pFactory->create(meta)) == NULL)
+                return false;
+            if ((o->pWrapper = new RenderWrapper(o->pModule)) == NULL)
+                return false;
+            o->pModule->init(o->pWrapper, reinterpret_cast<plug::IPort **>(o->vPorts));
+            o->pModule->set_sample_rate(s->nSampleRate);
+
+            for (size_t i=0; i<s->nParams; ++i)
+                o->vPorts[s->vParams[i].nPort]->set_value(s->vParams[i].fValue);
+            if (o->sSolo != NULL)
+            {
+                for (size_t i=0; i<n_ports; ++i)
+                {
+                    const char *id = meta->ports[i].id;
+                    if (!strncmp(id, "cs_", 3))
+                        o->vPorts[i]->set_value((!strcmp(id, o->sSolo)) ? 1.0f : 0.0f);
+                }
+            }
+            o->pModule->update_settings();
+
+            // The 5.1 layout of the surround bus occupies the first channels of the 7.1 bus
+            for (size_t i=0; i<n_ports; ++i)
+                if ((!strcmp(meta->ports[i].id, "layout")) && (o->vPorts[i]->value() < 0.5f))
+                    o->nOuts        = lsp_min(o->nOuts, meta::mixer::SURROUND_5_1_CHANNELS);
+
+            // Open the output file
+            if ((o->pFd = fopen(o->sPath, "wb")) == NULL)
+            {
+                printf("Could not create file '%s'\n", o->sPath);
+                return false;
+            }
+
+            return write_wav_header(o->pFd, o->nOuts, s->nSampleRate, 0);
+        }
+
+        static bool close_output(session_t *s, output_t *o, size_t n_ports, bool complete)
+        {
+            bool res = complete;
+            if (o->pFd != NULL)
+            {
+                if (res)
+                    res = write_wav_header(o->pFd, o->nOuts, s->nSampleRate, s->nFrames);
+                if (fclose(o->pFd) != 0)
+                    res = false;
+                o->pFd          = NULL;
+            }
+            if (o->pModule != NULL)
+            {
+                o->pModule->destroy();
+                delete o->pModule;
+                o->pModule      = NULL;
+            }
+            delete o->pWrapper;
+            o->pWrapper     = NULL;
+            if (o->vPorts != NULL)
+            {
+                for (size_t i=0; i<n_ports; ++i)
+                    delete o->vPorts[i];
+                delete [] o->vPorts;
+                o->vPorts       = NULL;
+            }
+
+            if ((complete) && (!res))
+                printf("Failed to render file '%s'\n", o->sPath);
+
+            return res;
+        }
+
+        static bool add_output(session_t *s, const char *path, const char *solo)
+        {
+            if (s->nOutputs >= OUTPUTS_MAX)
+            {
+                printf("Too many outputs\n");
+                return false;
+            }
+
+            output_t *o     = &s->vOutputs[s->nOutputs];
+            o->sPath        = path;
+            o->sSolo        = NULL;
+            o->vPorts       = NULL;
+            o->pModule      = NULL;
+            o->pWrapper     = NULL;
+            o->nOuts        = 0;
+            o->pFd          = NULL;
+            if (solo != NULL)
+            {
+                strncpy(s->vSolo[s->nOutputs], solo, sizeof(s->vSolo[0]) - 1);
+                s->vSolo[s->nOutputs][sizeof(s->vSolo[0]) - 1] = '\0';
+                o->sSolo        = s->vSolo[s->nOutputs];
+            }
+            ++s->nOutputs;
+
+            return true;
+        }
+
+        static bool render(session_t *s)
+        {
+            const meta::plugin_t *meta = s->pMeta;
+            size_t n_ports  = 0;
+            for (const meta::port_t *p = meta->ports; p->id != NULL; ++p)
+                ++n_ports;
+
+            float **inputs          = new float *[n_ports];
+            uint8_t *data           = NULL;
+            uint8_t *tmp            = NULL;
+            size_t offset           = 0;
+            bool res                = false;
+
+            if (inputs == NULL)
+                return false;
+
+            do
+            {
+                // Allocate input buffers shared by all plugin instances
+                size_t n_inputs         = 0;
+                for (size_t i=0; i<n_ports; ++i)
+                    if (meta::is_audio_in_port(&meta->ports[i]))
+                        ++n_inputs;
+
+                const size_t szof_block = align_size(s->nBlock * sizeof(float), DEFAULT_ALIGN);
+                float *buf              = alloc_aligned<float>(data, (szof_block / sizeof(float)) * lsp_max(n_inputs, size_t(1)), DEFAULT_ALIGN);
+                if (buf == NULL)
+                    break;
+                for (size_t i=0; i<n_ports; ++i)
+                {
+                    inputs[i]               = NULL;
+                    if (!meta::is_audio_in_port(&meta->ports[i]))
+                        continue;
+                    inputs[i]               = buf;
+                    dsp::fill_zero(buf, s->nBlock);
+                    buf                     = advance_ptr_bytes<float>(buf, szof_block);
+                }
+
+                if ((tmp = static_cast<uint8_t *>(malloc(s->nBlock * meta::mixer::SURROUND_CHANNELS * sizeof(float)))) == NULL)
+                    break;
+
+                // Create plugin instances
+                size_t opened           = 0;
+                for ( ; opened < s->nOutputs; ++opened)
+                    if (!open_output(s, &s->vOutputs[opened], inputs, n_ports))
+                        break;
+                if (opened < s->nOutputs)
+                    break;
+
+                // Stream sources through all plugin instances
+                for ( ; offset < s->nFrames; )
+                {
+                    const size_t count = lsp_min(s->nFrames - offset, s->nBlock);
+                    for (size_t i=0; i<s->nBindings; ++i)
+                    {
+                        const binding_t *b = &s->vBindings[i];
+                        read_source(inputs[b->nPort], b->pSource, b->nChannel, offset, count);
+                    }
+
+                    size_t written          = 0;
+                    for ( ; written < s->nOutputs; ++written)
+                    {
+                        output_t *o             = &s->vOutputs[written];
+                        o->pModule->process(count);
+                        if (!write_wav_frames(o->pFd, o->vOuts, o->nOuts, count, tmp))
+                            break;
+                    }
+                    if (written < s->nOutputs)
+                        break;
+                    offset     += count;
+                }
+
+                res = offset >= s->nFrames;
+            } while (false);
+
+            // Finalize outputs and release resources
+            for (size_t i=0; i<s->nOutputs; ++i)
+                if (!close_output(s, &s->vOutputs[i], n_ports, res))
+                    res = false;
+            free(tmp);
+            free_aligned(data);
+            delete [] inputs;
+
+            return res;
+        }
+
+        static bool render_session(session_t *s)
+        {
+            const char *master  = find_entry(s, "master");
+            system::time_t ts, te;
+            system::get_time(&ts);
+
+            if ((master != NULL) && (!add_output(s, master, NULL)))
+                return false;
+
+            for (size_t i=0; i<s->nEntries; ++i)
+            {
+                const entry_t *e = &s->vEntries[i];
+                if (strncmp(e->sKey, "stem_", 5))
+                    continue;
+
+                char solo[64];
+                snprintf(solo, sizeof(solo), "cs_%s", &e->sKey[5]);
+                if (find_port(s->pMeta, solo) < 0)
+                {
+                    printf("line %d: no strip for stem '%s'\n", int(e->nLine), e->sKey);
+                    return false;
+                }
+                if (!add_output(s, e->sValue, solo))
+                    return false;
+            }
+
+            if (s->nOutputs <= 0)
+            {
+                printf("No master or stem outputs specified\n");
+                return false;
+            }
+            if (!render(s))
+                return false;
+
+            system::get_time(&te);
+            const double elapsed    = double(te.seconds - ts.seconds) + double(te.nanos - ts.nanos) * 1e-9;
+            const double duration   = double(s->nFrames) * s->nOutputs / s->nSampleRate;
+            printf("Rendered %d output(s), %.3f s of audio in %.3f s (%.1fx real time)\n",
+                int(s->nOutputs), duration, elapsed, (elapsed > 0.0) ? duration / elapsed : 0.0);
+
+            return true;
+        }
+
+        static bool find_plugin(session_t *s)
+        {
+            const char *uid = find_entry(s, "plugin");
+            if (uid == NULL)
+            {
+                printf("The 'plugin' parameter is not specified\n");
+                return false;
+            }
+
+            for (plug::Factory *f = plug::Factory::root(); f != NULL; f = f->next())
+            {
+                for (size_t i=0; ; ++i)
+                {
+                    const meta::plugin_t *meta = f->enumerate(i);
+                    if (meta == NULL)
+                        break;
+                    if (strcmp(meta->uid, uid))
+                        continue;
+
+                    s->pFactory     = f;
+                    s->pMeta        = meta;
+                    return true;
+                }
+            }
+
+            printf("Unknown plugin '%s'\n", uid);
+            return false;
+        }
+    } /* namespace */
+} /* namespace lsp */
+
+MTEST_BEGIN("mixer", render)
+
+    MTEST_MAIN
+    {
+        MTEST_ASSERT_MSG(argc >= 1, "Usage: mixer.render <session-file>");
+        dsp::init();
+
+        session_t *s    = new session_t;
+        MTEST_ASSERT(s != NULL);
+        s->nEntries     = 0;
+        s->nSources     = 0;
+        s->nBindings    = 0;
+        s->nParams      = 0;
+        s->nOutputs     = 0;
+        s->pFactory     = NULL;
+        s->pMeta        = NULL;
+        s->nFrames      = 0;
+
+        const bool res  =
+            (load_session(s, argv[0])) &&
+            (find_plugin(s)) &&
+            (configure_session(s)) &&
+            (render_session(s));
+
+        destroy_session(s);
+        delete s;
+
+        MTEST_ASSERT(res);
+    }
+
+MTEST_END
@@ -0,0 +1,470 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/ptest.h>
+#include <lsp-plug.in/common/alloc.h>
+#include <lsp-plug.in/dsp/dsp.h>
+#include <lsp-plug.in/plug-fw/plug.h>
+#include <lsp-plug.in/plug-fw/meta/func.h>
+#include <lsp-plug.in/runtime/system.h>
+#include <lsp-plug.in/stdlib/math.h>
+#include <lsp-plug.in/stdlib/stdio.h>
+#include <lsp-plug.in/stdlib/string.h>
+#include <private/meta/mixer.h>
+
+#include <stdlib.h>
+
+#if defined(ARCH_X86)
+    #include <x86intrin.h>
+#endif /* ARCH_X86 */
+
+namespace lsp
+{
+    namespace
+    {
+        static constexpr size_t BLOCK_MIN       = 16;
+        static constexpr size_t BLOCK_MAX       = 8192;
+        static constexpr size_t WARMUP_BLOCKS   = 16;
+        static constexpr size_t MEASURE_BLOCKS  = 64;       // Minimum number of measured blocks
+        static constexpr ssize_t MEASURE_TIME   = 50000000; // Minimum measurement time, nanoseconds
+        static constexpr size_t FADE_BLOCKS     = 80;       // Length of the fade-out cycle, blocks
+        static constexpr float FADE_DECAY       = 0.25f;    // Decay of inputs per block, reaches subnormals within the cycle
+    #if defined(ARCH_X86)
+        static constexpr bool HAS_CYCLES        = true;     // The CPU cycle counter is available
+    #else
+        static constexpr bool HAS_CYCLES        = false;    // Generic timers of other architectures do not count CPU cycles
+    #endif /* ARCH_X86 */
+
+        enum pattern_t
+        {
+            PT_NONE,            // All strips are audible
+            PT_HALF_MUTED,      // Each second strip is muted
+            PT_SOLO_ONE,        // The first strip is soloed
+
+            PT_TOTAL
+        };
+
+        static const char * const pattern_names[] =
+        {
+            "none",
+            "half_muted",
+            "solo_one"
+        };
+
+        enum bench_mode_t
+        {
+            MD_STEADY,          // Parameters do not change
+            MD_RAMP,            // Channel faders change each block
+            MD_FADE,            // Channel faders fade out while inputs decay to silence
+
+            MD_TOTAL
+        };
+
+        static const char * const mode_names[] =
+        {
+            "steady",
+            "ramp",
+            "fade"
+        };
+
+        /**
+         * In-memory port
+         */
+        class BenchPort: public plug::IPort
+        {
+            private:
+                float          *vBuffer;
+                float          *vNoise;
+                float           fValue;
+                uint8_t        *pData;
+
+            public:
+                explicit BenchPort(const meta::port_t *meta): IPort(meta)
+                {
+                    vBuffer     = NULL;
+                    vNoise      = NULL;
+                    fValue      = meta->start;
+                    pData       = NULL;
+                }
+
+                virtual ~BenchPort() override
+                {
+                    free_aligned(pData);
+                }
+
+            public:
+                bool init()
+                {
+                    if (!meta::is_audio_port(pMetadata))
+                        return true;
+
+                    // Fill inputs with noise and clear outputs, the copy of noise restores inputs after the fade-out
+                    vBuffer     = alloc_aligned<float>(pData, BLOCK_MAX * 2, DEFAULT_ALIGN);
+                    if (vBuffer == NULL)
+                        return false;
+                    vNoise      = &vBuffer[BLOCK_MAX];
+                    for (size_t i=0; i<BLOCK_MAX; ++i)
+                        vNoise[i]   = (meta::is_audio_in_port(pMetadata)) ? float(rand()) / RAND_MAX - 0.5f : 0.0f;
+                    dsp::copy(vBuffer, vNoise, BLOCK_MAX);
+
+                    return true;
+                }
+
+                void fade(float k, size_t count)
+                {
+                    if (meta::is_audio_in_port(pMetadata))
+                        dsp::mul_k2(vBuffer, k, count);
+                }
+
+                void restore(size_t count)
+                {
+                    if (meta::is_audio_in_port(pMetadata))
+                        dsp::copy(vBuffer, vNoise, count);
+                }
+
+                bool has_prefix(const char *prefix) const
+                {
+                    return strncmp(pMetadata->id, prefix, strlen(prefix)) == 0;
+                }
+
+                // Wrappers expose the bypass port to the host as the inverted 'enabled' switch
+                virtual float value() override  { return (pMetadata->role == meta::R_BYPASS) ? 1.0f - fValue : fValue; }
+                virtual void set_value(float value) override { fValue = value; }
+                virtual void *buffer() override { return vBuffer; }
+        };
+
+        /**
+         * Wrapper that provides no services to the plugin
+         */
+        class BenchWrapper: public plug::IWrapper
+        {
+            public:
+                explicit BenchWrapper(plug::Module *plugin): IWrapper(plugin, NULL) {}
+        };
+
+        typedef struct bench_t
+        {
+            const meta::plugin_t   *pMeta;
+            plug::Module           *pModule;
+            BenchWrapper           *pWrapper;
+            BenchPort             **vPorts;
+            size_t                  nPorts;
+            size_t                  nStrips;
+            size_t                  nChannels;
+            bool                    bParallel;
+            bool                    bLoudness;
+        } bench_t;
+
+        typedef struct result_t
+        {
+            size_t                  nBlocks;
+            double                  fNsPerSample;
+            double                  fNsPerBlock;
+            double                  fCyclesPerBlock;
+        } result_t;
+
+        static inline ssize_t time_ns()
+        {
+            system::time_t ts;
+            system::get_time(&ts);
+            return ts.seconds * 1000000000 + ts.nanos;
+        }
+
+        static inline uint64_t cycles()
+        {
+        #if defined(ARCH_X86)
+            return __rdtsc();
+        #else
+            return 0;
+        #endif /* ARCH_X86 */
+        }
+
+        static void set_ports(bench_t *b, const char *prefix, float value)
+        {
+            for (size_t i=0; i<b->nPorts; ++i)
+            {
+                BenchPort *p = b->vPorts[i];
+                if (p->has_prefix(prefix))
+                    p->set_value(value);
+            }
+        }
+
+        static void fade_step(bench_t *b, size_t index, size_t block)
+        {
+            // Inputs decay into the subnormal range within the cycle while faders fade out to -inf dB
+            const size_t step   = index % FADE_BLOCKS;
+            for (size_t i=0; i<b->nPorts; ++i)
+            {
+                BenchPort *p = b->vPorts[i];
+                if (step == 0)
+                    p->restore(block);
+                else
+                    p->fade(FADE_DECAY, block);
+            }
+
+            set_ports(b, "cg_", ldexpf(1.0f, -int(step)));
+            b->pModule->update_settings();
+        }
+
+        static void set_pattern(bench_t *b, pattern_t pattern)
+        {
+            size_t strip = 0;
+            for (size_t i=0; i<b->nPorts; ++i)
+            {
+                BenchPort *p = b->vPorts[i];
+                if (p->has_prefix("cm_"))
+                    p->set_value(((pattern == PT_HALF_MUTED) && (strip & 1)) ? 1.0f : 0.0f);
+                else if (p->has_prefix("cs_"))
+                    p->set_value(((pattern == PT_SOLO_ONE) && (strip == 0)) ? 1.0f : 0.0f);
+                else if (p->has_prefix("cg_"))
+                    ++strip;
+            }
+        }
+
+        static void destroy_bench(bench_t *b)
+        {
+            if (b->pModule != NULL)
+            {
+                b->pModule->destroy();
+                delete b->pModule;
+                b->pModule  = NULL;
+            }
+            if (b->pWrapper != NULL)
+            {
+                delete b->pWrapper;
+                b->pWrapper = NULL;
+            }
+            if (b->vPorts != NULL)
+            {
+                for (size_t i=0; i<b->nPorts; ++i)
+                    delete b->vPorts[i];
+                delete [] b->vPorts;
+                b->vPorts   = NULL;
+            }
+        }
+
+        static bool init_bench(bench_t *b, plug::Factory *f, const meta::plugin_t *meta)
+        {
+            b->pMeta        = meta;
+            b->pModule      = NULL;
+            b->pWrapper     = NULL;
+            b->vPorts       = NULL;
+            b->nPorts       = 0;
+            b->nStrips      = 0;
+            b->nChannels    = 0;
+            b->bParallel    = false;
+            b->bLoudness    = false;
+
+            for (const meta::port_t *p = meta->ports; p->id != NULL; ++p)
+                ++b->nPorts;
+
+            // Create ports
+            b->vPorts       = new BenchPort *[b->nPorts];
+            if (b->vPorts == NULL)
+                return false;
+            for (size_t i=0; i<b->nPorts; ++i)
+                b->vPorts[i]            = NULL;
+            for (size_t i=0; i<b->nPorts; ++i)
+            {
+                const meta::port_t *p   = &meta->ports[i];
+                b->vPorts[i]            = new BenchPort(p);
+                if ((b->vPorts[i] == NULL) || (!b->vPorts[i]->init()))
+                    return false;
+
+                if (b->vPorts[i]->has_prefix("cg_"))
+                    ++b->nStrips;
+                else if (b->vPorts[i]->has_prefix("threads"))
+                    b->bParallel    = true;
+                else if (b->vPorts[i]->has_prefix("lmtr"))
+                    b->bLoudness    = true;
+                else if (meta::is_audio_out_port(p) && (b->vPorts[i]->has_prefix("out")))
+                    ++b->nChannels;
+            }
+
+            // Create the plugin
+            if ((b->pModule = f->create(meta)) == NULL)
+                return false;
+            if ((b->pWrapper = new BenchWrapper(b->pModule)) == NULL)
+                return false;
+
+            b->pModule->init(b->pWrapper, reinterpret_cast<plug::IPort **>(b->vPorts));
+            b->pModule->set_sample_rate(48000);
+            b->pModule->update_settings();
+
+            return true;
+        }
+
+        static void measure(bench_t *b, size_t block, bench_mode_t mode, result_t *res)
+        {
+            plug::Module *m     = b->pModule;
+            size_t blocks       = 0;
+            float gain          = 1.0f;
+
+            // Warm up caches and let the parallel workers spin up
+            for (size_t i=0; i<WARMUP_BLOCKS; ++i)
+                m->process(block);
+
+            ssize_t t_start     = time_ns();
+            uint64_t c_start    = cycles();
+            ssize_t t_end       = t_start;
+
+            do
+            {
+                if (mode == MD_RAMP)
+                {
+                    gain                = (gain > 0.75f) ? 0.5f : 1.0f;
+                    set_ports(b, "cg_", gain);
+                    m->update_settings();
+                }
+                else if (mode == MD_FADE)
+                    fade_step(b, blocks, block);
+                m->process(block);
+                ++blocks;
+
+                if (blocks >= MEASURE_BLOCKS)
+                    t_end               = time_ns();
+            } while ((blocks < MEASURE_BLOCKS) || ((t_end - t_start) < MEASURE_TIME));
+
+            const uint64_t c_end = cycles();
+
+            res->nBlocks            = blocks;
+            res->fNsPerBlock        = double(t_end - t_start) / blocks;
+            res->fNsPerSample       = res->fNsPerBlock / block;
+            res->fCyclesPerBlock    = double(c_end - c_start) / blocks;
+
+            // Restore inputs for further measurements
+            if (mode == MD_FADE)
+            {
+                for (size_t i=0; i<b->nPorts; ++i)
+                    b->vPorts[i]->restore(BLOCK_MAX);
+            }
+        }
+
+        static bool selected(const meta::plugin_t *meta, int argc, const char **argv)
+        {
+            if (argc <= 0)
+                return true;
+            for (int i=0; i<argc; ++i)
+                if (!strcmp(meta->uid, argv[i]))
+                    return true;
+            return false;
+        }
+    } /* namespace */
+} /* namespace lsp */
+
+PTEST_BEGIN("mixer", process, 30, 1)
+
+    void run_bench(FILE *out, bench_t *b)
+    {
+        static const size_t thread_counts[] = { 1, 4 };
+        const size_t n_threads = (b->bParallel) ? 2 : 1;
+        const size_t n_loudness = (b->bLoudness) ? 2 : 1;
+
+        // Each configuration is measured with loudness meters off and on to show their overhead
+        for (size_t ci=0; ci<n_loudness * n_threads; ++ci)
+        {
+            const size_t lm      = ci / n_threads;
+            const size_t threads = thread_counts[ci % n_threads];
+            set_ports(b, "lmtr", lm);
+            if (b->bParallel)
+            {
+                set_ports(b, "threads", threads);
+                set_ports(b, "mt_min", meta::mixer::MT_BLOCK_MIN);
+            }
+
+            for (size_t pattern=0; pattern<PT_TOTAL; ++pattern)
+            {
+                set_pattern(b, pattern_t(pattern));
+
+                for (size_t mode=0; mode<MD_TOTAL; ++mode)
+                {
+                    // Reset parameters to the steady state before the measurement
+                    set_ports(b, "cg_", 1.0f);
+                    b->pModule->update_settings();
+
+                    for (size_t block=BLOCK_MIN; block<=BLOCK_MAX; block <<= 1)
+                    {
+                        result_t res;
+                        measure(b, block, bench_mode_t(mode), &res);
+
+                        fprintf(out, "%s,%d,%d,%d,%d,%d,%s,%s,%d,%.4f,%.1f",
+                            b->pMeta->uid, int(b->nStrips), int(b->nChannels), int(threads), int(lm),
+                            int(block), mode_names[mode], pattern_names[pattern],
+                            int(res.nBlocks), res.fNsPerSample, res.fNsPerBlock);
+                        printf("%-20s strips=%-3d threads=%d lmtr=%d block=%-5d %-6s %-10s: %9.4f ns/sample",
+                            b->pMeta->uid, int(b->nStrips), int(threads), int(lm),
+                            int(block), mode_names[mode], pattern_names[pattern],
+                            res.fNsPerSample);
+                        if (HAS_CYCLES)
+                        {
+                            fprintf(out, ",%.1f", res.fCyclesPerBlock);
+                            printf(", %12.1f cycles/block", res.fCyclesPerBlock);
+                        }
+                        fprintf(out, "\n");
+                        printf("\n");
+                    }
+                }
+            }
+        }
+    }
+
+    PTEST_MAIN
+    {
+        dsp::init();
+
+        // Results are written in CSV format to the temporary directory
+        char path[PATH_MAX];
+        snprintf(path, sizeof(path), "%s/ptest-mixer-process.csv", tempdir());
+        FILE *out = fopen(path, "w");
+        if (out == NULL)
+        {
+            printf("Could not open output file %s\n", path);
+            return;
+        }
+        // The cycles column is present only for architectures with the CPU cycle counter
+        fprintf(out, "plugin,strips,channels,threads,loudness,block,mode,pattern,blocks,ns_per_sample,ns_per_block%s\n",
+            (HAS_CYCLES) ? ",cycles_per_block" : "");
+
+        // Benchmark each mixer plugin provided by plugin factories
+        for (plug::Factory *f = plug::Factory::root(); f != NULL; f = f->next())
+        {
+            for (size_t i=0; ; ++i)
+            {
+                const meta::plugin_t *meta = f->enumerate(i);
+                if (meta == NULL)
+                    break;
+                if ((strncmp(meta->uid, "mixer_", 6)) || (!selected(meta, argc, argv)))
+                    continue;
+
+                bench_t b;
+                if (init_bench(&b, f, meta))
+                    run_bench(out, &b);
+                else
+                    printf("Could not initialize benchmark for plugin %s\n", meta->uid);
+                destroy_bench(&b);
+            }
+        }
+
+        fclose(out);
+        printf("Results have been written to %s\n", path);
+    }
+
+PTEST_END
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2026 Linux Studio Plugins Project <https://lsp-plug.in/>
+ *           (C) 2026 Vladimir Sadovnikov <sadko4u@gmail.com>
+ *
+ * This file is part of lsp-plugins-mixer
+ * Created on: 17 окт. 2026 г.
+ *
+ * lsp-plugins-mixer is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * lsp-plugins-mixer is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with lsp-plugins-mixer. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <lsp-plug.in/test-fw/utest.h>
+#include <lsp-plug.in/common/atomic.h>
+#include <lsp-plug.in/ipc/Thread.h>
+
+#include <private/plugins/mixer_exchange.h>
+
+namespace lsp
+{
+    namespace
+    {
+        static constexpr size_t PARAMS          = 16;
+        static constexpr size_t PUBLICATIONS    = 100000;
+
+        /**
+         * Control thread that publishes all parameters set to the number of the publication
+         */
+        class Writer: public ipc::Thread
+        {
+            private:
+                plugins::mix::ParamExchange    *pExchange;
+                uatomic_t                       nFailed;
+
+            public:
+                explicit Writer(plugins::mix::ParamExchange *exchange)
+                {
+                    pExchange   = exchange;
+                    nFailed     = 0;
+                }
+
+            public:
+                inline size_t failed()      { return atomic_load(&nFailed); }
+
+                virtual status_t run() override
+                {
+                    for (size_t i=1; i<=PUBLICATIONS; ++i)
+                    {
+                        if (!pExchange->begin())
+                        {
+                            atomic_add(&nFailed, uatomic_t(1));
+                            return STATUS_BAD_STATE;
+                        }
+                        for (size_t j=0; j<PARAMS; ++j)
+                            pExchange->set(j, float(i));
+                        pExchange->publish();
+                    }
+
+                    return STATUS_OK;
+                }
+        };
+    } /* namespace */
+} /* namespace lsp */
+
+UTEST_BEGIN("mixer", exchange)
+
+    void test_publish_fetch_take()
+    {
+        printf("Testing publish, fetch and take...\n");
+
+        plugins::mix::ParamExchange x;
+        float value = -1.0f;
+
+        UTEST_ASSERT(x.init(PARAMS) == STATUS_OK);
+        UTEST_ASSERT(x.size() == PARAMS);
+
+        // Nothing is published after initialization
+        UTEST_ASSERT(!x.fetch());
+        for (size_t i=0; i<PARAMS; ++i)
+            UTEST_ASSERT(!x.take(i, &value));
+
+        // Published values are not visible until fetched
+        UTEST_ASSERT(x.begin());
+        x.set(2, 5.0f);
+        UTEST_ASSERT(x.get(2) == 5.0f);
+        x.publish();
+        UTEST_ASSERT(!x.take(2, &value));
+
+        // Only changed values are taken, and only once
+        UTEST_ASSERT(x.fetch());
+        UTEST_ASSERT(x.take(2, &value));
+        UTEST_ASSERT(value == 5.0f);
+        UTEST_ASSERT(!x.take(2, &value));
+        for (size_t i=0; i<PARAMS; ++i)
+            if (i != 2)
+                UTEST_ASSERT(!x.take(i, &value));
+        UTEST_ASSERT(!x.fetch());
+
+        // Setting the same value is still a change
+        UTEST_ASSERT(x.begin());
+        x.set(2, 5.0f);
+        x.publish();
+        UTEST_ASSERT(x.fetch());
+        value = -1.0f;
+        UTEST_ASSERT(x.take(2, &value));
+        UTEST_ASSERT(value == 5.0f);
+
+        x.destroy();
+        UTEST_ASSERT(x.size() == 0);
+    }
+
+    void test_skipped_publications()
+    {
+        printf("Testing changes of skipped publications...\n");
+
+        plugins::mix::ParamExchange x;
+        float value = -1.0f;
+
+        UTEST_ASSERT(x.init(PARAMS) == STATUS_OK);
+
+        // Three publications with different parameters, the reader fetches only the last one
+        UTEST_ASSERT(x.begin());
+        x.set(0, 1.0f);
+        x.set(3, 3.0f);
+        x.publish();
+
+        UTEST_ASSERT(x.begin());
+        x.set(1, 2.0f);
+        x.publish();
+
+        UTEST_ASSERT(x.begin());
+        x.set(3, 4.0f);
+        x.publish();
+
+        UTEST_ASSERT(x.fetch());
+        UTEST_ASSERT(!x.fetch());
+
+        UTEST_ASSERT(x.take(0, &value));
+        UTEST_ASSERT(value == 1.0f);
+        UTEST_ASSERT(x.take(1, &value));
+        UTEST_ASSERT(value == 2.0f);
+        UTEST_ASSERT(x.take(3, &value));
+        UTEST_ASSERT(value == 4.0f);
+        UTEST_ASSERT(!x.take(2, &value));
+
+        // Values already taken are not taken again after the next publication
+        UTEST_ASSERT(x.begin());
+        x.set(2, 6.0f);
+        x.publish();
+        UTEST_ASSERT(x.fetch());
+        UTEST_ASSERT(!x.take(0, &value));
+        UTEST_ASSERT(!x.take(1, &value));
+        UTEST_ASSERT(!x.take(3, &value));
+        UTEST_ASSERT(x.take(2, &value));
+        UTEST_ASSERT(value == 6.0f);
+    }
+
+    void test_second_writer()
+    {
+        printf("Testing the second writer...\n");
+
+        plugins::mix::ParamExchange x;
+        float value = -1.0f;
+
+        UTEST_ASSERT(x.init(PARAMS) == STATUS_OK);
+
+        UTEST_ASSERT(x.begin());
+        UTEST_ASSERT(!x.begin());
+        x.set(0, 1.0f);
+        UTEST_ASSERT(!x.begin());
+        x.publish();
+
+        // The writer is released by the publication
+        UTEST_ASSERT(x.begin());
+        x.set(0, 2.0f);
+        x.publish();
+
+        UTEST_ASSERT(x.fetch());
+        UTEST_ASSERT(x.take(0, &value));
+        UTEST_ASSERT(value == 2.0f);
+    }
+
+    void test_concurrent_writer()
+    {
+        printf("Testing the concurrent writer...\n");
+
+        plugins::mix::ParamExchange x;
+        UTEST_ASSERT(x.init(PARAMS) == STATUS_OK);
+
+        Writer w(&x);
+        UTEST_ASSERT(w.start() == STATUS_OK);
+
+        // Each publication sets all parameters to the same value, so the fetched slot
+        // should never mix values of different publications and values should never decrease
+        float last      = 0.0f;
+        size_t fetched  = 0;
+        while (last < float(PUBLICATIONS))
+        {
+            if (!x.fetch())
+            {
+                UTEST_ASSERT(w.failed() == 0);
+                continue;
+            }
+            ++fetched;
+
+            float first = -1.0f;
+            for (size_t i=0; i<PARAMS; ++i)
+            {
+                float value = -1.0f;
+                UTEST_ASSERT_MSG(x.take(i, &value), "Parameter %d has not been changed", int(i));
+                if (i == 0)
+                    first       = value;
+                UTEST_ASSERT_MSG(value == first, "Parameter %d = %f, expected %f", int(i), value, first);
+            }
+            UTEST_ASSERT_MSG(first > last, "Value %f follows value %f", first, last);
+            last        = first;
+        }
+
+        UTEST_ASSERT(w.join() == STATUS_OK);
+        UTEST_ASSERT(w.failed() == 0);
+        UTEST_ASSERT(!x.fetch());
+        printf("  fetched %d of %d publications\n", int(fetched), int(PUBLICATIONS));
+    }
+
+    UTEST_MAIN
+    {
+        test_publish_fetch_take();
+        test_skipped_publications();
+        test_second_writer();
+        test_concurrent_writer();
+    }
+
+UTEST_END